@@ -0,0 +1,380 @@
+/** Fast block codec for DDSS data payloads (lossless and error-bounded lossy).
+    Compressed image: [header][block table][compressed blocks], where the original data is
+    split into blocks of CODEC_BLOCK bytes which are compressed independently (in parallel).
+    Each compressed block starts with a flag byte:
+     BLK_RAW: original bytes (incompressible block);
+     BLK_LZ:  LZ(byte-shuffle(original bytes));
+     BLK_QNT: LZ(byte-shuffle(zigzag(round(x/(2*tol))))), error-bounded lossy.
+    The byte-shuffle groups the k-th bytes of all elements together, which exposes the
+    redundancy of exponents/high-order bytes of floating point data to the LZ stage. **/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <omp.h>
+
+#include "ddss_codec.h"
+
+#define CODEC_MAGIC 0x504D4344u //codec image signature
+#define CODEC_BLOCK (256*1024)  //block size in bytes of the original data (multiple of 8)
+#define LZ_MIN_MATCH 4          //min LZ match length in bytes
+#define LZ_HASH_LOG 14          //log2 of the LZ hash table size
+#define LZ_MAX_OFFSET 65535     //max LZ match offset in bytes
+
+//Compressed image header (64 bytes):
+typedef struct{
+ uint32_t magic;       //codec image signature
+ int32_t mode;         //compression mode
+ int32_t elem_size;    //size of a real data element in bytes (4 or 8)
+ int32_t num_blocks;   //number of blocks
+ uint64_t orig_bytes;  //size of the original data in bytes
+ uint64_t comp_bytes;  //size of the full compressed image in bytes (including the header)
+ double tol;           //absolute error tolerance (lossy mode)
+ uint64_t reserved[3];
+} codec_header_t;
+
+enum {BLK_RAW=0, BLK_LZ=1, BLK_QNT=2};
+
+static size_t num_blocks(size_t bytes)
+{
+ return (bytes+CODEC_BLOCK-1)/CODEC_BLOCK;
+}
+
+static void shuffle(const unsigned char * in, unsigned char * out, size_t bytes, int w)
+/** Byte-shuffle: out[b*n+i] = in[i*w+b], the trailing bytes (if any) are copied as is. **/
+{
+ size_t i,n;
+ int b;
+
+ n=bytes/w;
+ for(b=0; b < w; ++b){
+  unsigned char * o = out+b*n;
+  for(i=0; i < n; ++i) o[i]=in[i*w+b];
+ }
+ for(i=n*w; i < bytes; ++i) out[i]=in[i];
+ return;
+}
+
+static void unshuffle(const unsigned char * in, unsigned char * out, size_t bytes, int w)
+/** Inverse byte-shuffle. **/
+{
+ size_t i,n;
+ int b;
+
+ n=bytes/w;
+ for(b=0; b < w; ++b){
+  const unsigned char * s = in+b*n;
+  for(i=0; i < n; ++i) out[i*w+b]=s[i];
+ }
+ for(i=n*w; i < bytes; ++i) out[i]=in[i];
+ return;
+}
+
+static unsigned char * lz_put_len(unsigned char * op, size_t len)
+{
+ while(len >= 255){*op++=255; len-=255;}
+ *op++=(unsigned char)len;
+ return op;
+}
+
+static size_t lz_compress(const unsigned char * src, size_t n, unsigned char * dst, size_t cap)
+/** LZ77 compression (LZ4-like sequences). Returns the compressed size or 0 if it does not fit into <cap>. **/
+{
+ uint32_t htab[1<<LZ_HASH_LOG];
+ const unsigned char * ip = src;
+ const unsigned char * anchor = src;
+ const unsigned char * iend = src+n;
+ unsigned char * op = dst;
+ unsigned char * oend = dst+cap;
+ size_t lit,ml;
+
+ memset(htab,0,sizeof(htab));
+ while(ip+LZ_MIN_MATCH <= iend){
+  uint32_t seq,h;
+  const unsigned char * ref;
+  memcpy(&seq,ip,sizeof(seq));
+  h=(seq*2654435761u)>>(32-LZ_HASH_LOG);
+  ref=src+htab[h]; htab[h]=(uint32_t)(ip-src);
+  if(ref < ip && (size_t)(ip-ref) <= LZ_MAX_OFFSET && memcmp(ref,ip,LZ_MIN_MATCH) == 0){
+   ml=LZ_MIN_MATCH; while(ip+ml < iend && ref[ml] == ip[ml]) ++ml;
+   lit=(size_t)(ip-anchor);
+   if((size_t)(oend-op) < 1+(lit/255+1)+lit+2+((ml-LZ_MIN_MATCH)/255+1)) return 0;
+   *op=(unsigned char)(((lit < 15 ? lit : 15)<<4) | ((ml-LZ_MIN_MATCH) < 15 ? (ml-LZ_MIN_MATCH) : 15));
+   ++op;
+   if(lit >= 15) op=lz_put_len(op,lit-15);
+   memcpy(op,anchor,lit); op+=lit;
+   *op++=(unsigned char)((ip-ref)&255); *op++=(unsigned char)((ip-ref)>>8);
+   if(ml-LZ_MIN_MATCH >= 15) op=lz_put_len(op,ml-LZ_MIN_MATCH-15);
+   ip+=ml; anchor=ip;
+  }else{
+   ++ip;
+  }
+ }
+ lit=(size_t)(iend-anchor); //last literals
+ if((size_t)(oend-op) < 1+(lit/255+1)+lit) return 0;
+ *op++=(unsigned char)((lit < 15 ? lit : 15)<<4);
+ if(lit >= 15) op=lz_put_len(op,lit-15);
+ memcpy(op,anchor,lit); op+=lit;
+ return (size_t)(op-dst);
+}
+
+static int lz_decompress(const unsigned char * src, size_t n, unsigned char * dst, size_t orig)
+/** LZ77 decompression of exactly <orig> bytes. Returns 0 on success. **/
+{
+ const unsigned char * ip = src;
+ const unsigned char * iend = src+n;
+ unsigned char * op = dst;
+ unsigned char * oend = dst+orig;
+ const unsigned char * mp;
+ size_t lit,ml,offs,k;
+ unsigned int token;
+
+ while(ip < iend){
+  token=*ip++;
+  lit=token>>4;
+  if(lit == 15){do{if(ip >= iend) return 1; k=*ip++; lit+=k;}while(k == 255);}
+  if((size_t)(iend-ip) < lit || (size_t)(oend-op) < lit) return 2;
+  memcpy(op,ip,lit); op+=lit; ip+=lit;
+  if(ip == iend) break; //last sequence
+  if(iend-ip < 2) return 3;
+  offs=(size_t)ip[0] | ((size_t)ip[1]<<8); ip+=2;
+  if(offs == 0 || offs > (size_t)(op-dst)) return 4;
+  ml=(token&15);
+  if(ml == 15){do{if(ip >= iend) return 5; k=*ip++; ml+=k;}while(k == 255);}
+  ml+=LZ_MIN_MATCH;
+  if((size_t)(oend-op) < ml) return 6;
+  mp=op-offs;
+  if(offs >= ml){
+   memcpy(op,mp,ml);
+  }else{
+   for(k=0; k < ml; ++k) op[k]=mp[k]; //overlapping copy
+  }
+  op+=ml;
+ }
+ return (op == oend) ? 0 : 7;
+}
+
+static int quantize(const unsigned char * src, size_t bytes, int w, double tol, unsigned char * out)
+/** Error-bounded quantization with zigzag encoding: Returns 0 on success,
+    non-zero if some element cannot be represented within the tolerance. **/
+{
+ const double step = 2.0*tol;
+ size_t i,n;
+
+ n=bytes/w;
+ if(w == 4){
+  const float * x = (const float*)src;
+  uint32_t * q = (uint32_t*)out;
+  for(i=0; i < n; ++i){
+   double v = (double)x[i]/step;
+   int32_t k;
+   if(!(fabs(v) < 2147483647.0)) return 1; //also catches NaN and Inf
+   k=(int32_t)nearbyint(v);
+   if(!(fabs((double)x[i]-(double)((float)((double)k*step))) <= tol)) return 2;
+   q[i]=((uint32_t)k<<1)^(uint32_t)(k>>31);
+  }
+ }else{
+  const double * x = (const double*)src;
+  uint64_t * q = (uint64_t*)out;
+  for(i=0; i < n; ++i){
+   double v = x[i]/step;
+   int64_t k;
+   if(!(fabs(v) < 4611686018427387904.0)) return 1;
+   k=(int64_t)nearbyint(v);
+   if(!(fabs(x[i]-(double)k*step) <= tol)) return 2;
+   q[i]=((uint64_t)k<<1)^(uint64_t)(k>>63);
+  }
+ }
+ for(i=n*w; i < bytes; ++i) out[i]=src[i];
+ return 0;
+}
+
+static void dequantize(const unsigned char * in, size_t bytes, int w, double tol, unsigned char * dst)
+{
+ const double step = 2.0*tol;
+ size_t i,n;
+
+ n=bytes/w;
+ if(w == 4){
+  const uint32_t * q = (const uint32_t*)in;
+  float * x = (float*)dst;
+  for(i=0; i < n; ++i){int32_t k = (int32_t)(q[i]>>1)^-(int32_t)(q[i]&1u); x[i]=(float)((double)k*step);}
+ }else{
+  const uint64_t * q = (const uint64_t*)in;
+  double * x = (double*)dst;
+  for(i=0; i < n; ++i){int64_t k = (int64_t)(q[i]>>1)^-(int64_t)(q[i]&1u); x[i]=(double)k*step;}
+ }
+ for(i=n*w; i < bytes; ++i) dst[i]=in[i];
+ return;
+}
+
+static size_t compress_block(const unsigned char * src, size_t n, int w, int mode, double tol,
+                             unsigned char * dst, unsigned char * work)
+/** Compresses a block of <n> bytes into <dst> (capacity n+1). Returns the compressed block size. **/
+{
+ size_t m;
+
+ m=0;
+ if(mode == DDSS_CODEC_LOSSY){
+  if(quantize(src,n,w,tol,work+n) == 0){
+   shuffle(work+n,work,n,w);
+   m=lz_compress(work,n,dst+1,n-1);
+   if(m > 0) dst[0]=BLK_QNT;
+  }else{
+   mode=DDSS_CODEC_LOSSLESS; //fall back to lossless for this block
+  }
+ }
+ if(mode == DDSS_CODEC_LOSSLESS){
+  shuffle(src,work,n,w);
+  m=lz_compress(work,n,dst+1,n-1);
+  if(m > 0) dst[0]=BLK_LZ;
+ }
+ if(m == 0){ //store as is
+  dst[0]=BLK_RAW; memcpy(dst+1,src,n); m=n;
+ }
+ return m+1;
+}
+
+static int decompress_block(const unsigned char * src, size_t m, int w, double tol,
+                            unsigned char * dst, size_t n, unsigned char * work)
+/** Decompresses a block of <m> compressed bytes into <n> original bytes. Returns 0 on success. **/
+{
+ if(m < 1) return 1;
+ switch(src[0]){
+ case BLK_RAW:
+  if(m-1 != n) return 2;
+  memcpy(dst,src+1,n);
+  break;
+ case BLK_LZ:
+  if(lz_decompress(src+1,m-1,work,n) != 0) return 3;
+  unshuffle(work,dst,n,w);
+  break;
+ case BLK_QNT:
+  if(lz_decompress(src+1,m-1,work,n) != 0) return 4;
+  unshuffle(work,work+n,n,w);
+  dequantize(work+n,n,w,tol,dst);
+  break;
+ default:
+  return 5;
+ }
+ return 0;
+}
+
+size_t ddss_codec_bound(size_t bytes)
+/** Returns the max size of the compressed image for <bytes> of original data. **/
+{
+ size_t nb = num_blocks(bytes);
+ return sizeof(codec_header_t)+nb*sizeof(uint64_t)+nb+bytes;
+}
+
+int ddss_codec_compress(const void * src, size_t bytes, int elem_size, int mode, double tol,
+                        void * dst, size_t dst_capacity, size_t * comp_bytes)
+/** Compresses <bytes> of data consisting of real elements of size <elem_size> (4 or 8 bytes, complex data
+    are treated as pairs of reals) into <dst>, which must be at least ddss_codec_bound(bytes) bytes large.
+    In the lossy mode, the absolute error of each element will not exceed <tol>. **/
+{
+ codec_header_t hdr;
+ uint64_t * btab;
+ unsigned char * body;
+ size_t nb,total;
+ long long i;
+ int errc;
+
+ if(src == NULL || dst == NULL || comp_bytes == NULL) return DDSS_CODEC_INVALID_ARGS;
+ if(elem_size != 4 && elem_size != 8) return DDSS_CODEC_INVALID_ARGS;
+ if(mode < DDSS_CODEC_NONE || mode > DDSS_CODEC_LOSSY) return DDSS_CODEC_INVALID_ARGS;
+ if(mode == DDSS_CODEC_LOSSY && !(tol > 0.0)) return DDSS_CODEC_INVALID_ARGS;
+ if(dst_capacity < ddss_codec_bound(bytes)) return DDSS_CODEC_INSUFFICIENT_SPACE;
+ nb=num_blocks(bytes);
+ btab=(uint64_t*)((unsigned char*)dst+sizeof(codec_header_t));
+ body=(unsigned char*)(btab+nb);
+ errc=DDSS_CODEC_SUCCESS;
+ //Compress all blocks at their worst-case positions:
+#pragma omp parallel for schedule(dynamic) if(nb > 1) reduction(max:errc)
+ for(i=0; i < (long long)nb; ++i){
+  size_t boff = (size_t)i*CODEC_BLOCK;
+  size_t n = (bytes-boff < CODEC_BLOCK) ? bytes-boff : CODEC_BLOCK;
+  unsigned char * work = (unsigned char*)malloc(2*n);
+  if(work != NULL){
+   btab[i]=(uint64_t)compress_block((const unsigned char*)src+boff,n,elem_size,mode,tol,body+(size_t)i*(CODEC_BLOCK+1),work);
+   free(work);
+  }else{
+   errc=DDSS_CODEC_INSUFFICIENT_SPACE;
+  }
+ }
+ if(errc != DDSS_CODEC_SUCCESS) return errc;
+ //Compact the compressed blocks:
+ total=0;
+ for(i=0; i < (long long)nb; ++i){
+  if(total != (size_t)i*(CODEC_BLOCK+1)) memmove(body+total,body+(size_t)i*(CODEC_BLOCK+1),(size_t)btab[i]);
+  total+=(size_t)btab[i];
+ }
+ memset(&hdr,0,sizeof(hdr));
+ hdr.magic=CODEC_MAGIC; hdr.mode=mode; hdr.elem_size=elem_size; hdr.num_blocks=(int32_t)nb;
+ hdr.orig_bytes=(uint64_t)bytes; hdr.comp_bytes=(uint64_t)(sizeof(codec_header_t)+nb*sizeof(uint64_t)+total);
+ hdr.tol=(mode == DDSS_CODEC_LOSSY) ? tol : 0.0;
+ memcpy(dst,&hdr,sizeof(hdr));
+ *comp_bytes=(size_t)hdr.comp_bytes;
+ return DDSS_CODEC_SUCCESS;
+}
+
+int ddss_codec_decompress(const void * src, size_t comp_bytes, void * dst, size_t dst_capacity, size_t * orig_bytes)
+/** Decompresses a compressed image of size <comp_bytes> (or larger) into <dst>. **/
+{
+ codec_header_t hdr;
+ const uint64_t * btab;
+ const unsigned char * body;
+ size_t * boffs;
+ size_t nb,total;
+ long long i;
+ int errc;
+
+ if(src == NULL || dst == NULL || orig_bytes == NULL) return DDSS_CODEC_INVALID_ARGS;
+ if(comp_bytes < sizeof(codec_header_t)) return DDSS_CODEC_CORRUPTED;
+ memcpy(&hdr,src,sizeof(hdr));
+ if(hdr.magic != CODEC_MAGIC || hdr.comp_bytes > (uint64_t)comp_bytes) return DDSS_CODEC_CORRUPTED;
+ if(hdr.elem_size != 4 && hdr.elem_size != 8) return DDSS_CODEC_CORRUPTED;
+ nb=num_blocks((size_t)hdr.orig_bytes);
+ if((size_t)hdr.num_blocks != nb || sizeof(codec_header_t)+nb*sizeof(uint64_t) > (size_t)hdr.comp_bytes) return DDSS_CODEC_CORRUPTED;
+ if((size_t)hdr.orig_bytes > dst_capacity) return DDSS_CODEC_INSUFFICIENT_SPACE;
+ btab=(const uint64_t*)((const unsigned char*)src+sizeof(codec_header_t));
+ body=(const unsigned char*)(btab+nb);
+ boffs=(size_t*)malloc((nb+1)*sizeof(size_t));
+ if(boffs == NULL) return DDSS_CODEC_INSUFFICIENT_SPACE;
+ total=0;
+ for(i=0; i < (long long)nb; ++i){boffs[i]=total; total+=(size_t)btab[i];}
+ if(sizeof(codec_header_t)+nb*sizeof(uint64_t)+total != (size_t)hdr.comp_bytes){free(boffs); return DDSS_CODEC_CORRUPTED;}
+ errc=DDSS_CODEC_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if(nb > 1) reduction(max:errc)
+ for(i=0; i < (long long)nb; ++i){
+  size_t boff = (size_t)i*CODEC_BLOCK;
+  size_t n = ((size_t)hdr.orig_bytes-boff < CODEC_BLOCK) ? (size_t)hdr.orig_bytes-boff : CODEC_BLOCK;
+  unsigned char * work = (unsigned char*)malloc(2*n);
+  if(work != NULL){
+   if(decompress_block(body+boffs[i],(size_t)btab[i],hdr.elem_size,hdr.tol,(unsigned char*)dst+boff,n,work) != 0)
+    errc=DDSS_CODEC_CORRUPTED;
+   free(work);
+  }else{
+   errc=DDSS_CODEC_INSUFFICIENT_SPACE;
+  }
+ }
+ free(boffs);
+ if(errc == DDSS_CODEC_SUCCESS) *orig_bytes=(size_t)hdr.orig_bytes;
+ return errc;
+}
+
+int ddss_codec_info(const void * src, size_t * orig_bytes, size_t * comp_bytes, int * mode)
+/** Returns the original size, compressed size, and compression mode of a compressed image. **/
+{
+ codec_header_t hdr;
+
+ if(src == NULL) return DDSS_CODEC_INVALID_ARGS;
+ memcpy(&hdr,src,sizeof(hdr));
+ if(hdr.magic != CODEC_MAGIC) return DDSS_CODEC_CORRUPTED;
+ if(orig_bytes != NULL) *orig_bytes=(size_t)hdr.orig_bytes;
+ if(comp_bytes != NULL) *comp_bytes=(size_t)hdr.comp_bytes;
+ if(mode != NULL) *mode=hdr.mode;
+ return DDSS_CODEC_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/** Fast block codec for DDSS data payloads (lossless and error-bounded lossy). **/
+
+#ifndef _DDSS_CODEC_H
+#define _DDSS_CODEC_H
+
+#include <stddef.h>
+
+//Compression modes:
+#define DDSS_CODEC_NONE 0     //no compression (plain copy with a codec header)
+#define DDSS_CODEC_LOSSLESS 1 //byte-shuffle + LZ (bit-exact)
+#define DDSS_CODEC_LOSSY 2    //error-bounded quantization + byte-shuffle + LZ (max absolute error <= tolerance)
+
+//Error codes:
+#define DDSS_CODEC_SUCCESS 0
+#define DDSS_CODEC_INVALID_ARGS 1
+#define DDSS_CODEC_INSUFFICIENT_SPACE 2
+#define DDSS_CODEC_CORRUPTED 3
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+ size_t ddss_codec_bound(size_t bytes);
+ int ddss_codec_compress(const void * src, size_t bytes, int elem_size, int mode, double tol,
+                         void * dst, size_t dst_capacity, size_t * comp_bytes);
+ int ddss_codec_decompress(const void * src, size_t comp_bytes, void * dst, size_t dst_capacity, size_t * orig_bytes);
+ int ddss_codec_info(const void * src, size_t * orig_bytes, size_t * comp_bytes, int * mode);
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,15 @@ int get_memory_stat(size_t *total_ram, size_t *free_ram, size_t *used_swap){ //n
  return 0;
 }
 
+void sleep_usec(int usec){ //suspends the calling thread (yields the CPU)
+ struct timespec req;
+ if(usec > 0){
+  req.tv_sec=(time_t)(usec/1000000); req.tv_nsec=((long)(usec%1000000))*1000L;
+  nanosleep(&req,NULL);
+ }
+ return;
+}
+
 double accu_time(void){
  struct timeval timer;
  if(gettimeofday(&timer,NULL)) return -1.0;
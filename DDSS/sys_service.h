@@ -7,6 +7,7 @@
 extern "C"{
 #endif
  int get_memory_stat(size_t *total_ram, size_t *free_ram, size_t *used_swap);
+ void sleep_usec(int usec);
  double accu_time(void);
  double system_clock(void);
 #ifdef __cplusplus
@@ -36,3 +36,31 @@ void resetBytePacket(BytePacket * packet,
  packet->position = new_position;
  return;
 }
+
+bool growBytePacket(BytePacket * packet,
+                    unsigned long long min_capacity)
+{
+ if(min_capacity <= packet->capacity) return true;
+ unsigned long long new_capacity = packet->capacity;
+ if(new_capacity == 0) new_capacity = BYTE_PACKET_CAPACITY;
+ while(new_capacity < min_capacity) new_capacity *= 2;
+ void * new_addr = realloc(packet->base_addr,new_capacity);
+ if(new_addr == NULL) return false;
+ packet->base_addr = new_addr;
+ packet->capacity = new_capacity;
+ return true;
+}
+
+int alignBytePacket(BytePacket * packet,
+                    unsigned long long alignment)
+{
+ assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+ unsigned long long new_position = (packet->position + (alignment - 1)) & ~(alignment - 1); //relative to the base address
+ if(new_position > packet->position){
+  if(!reserveBytePacket(packet,new_position - packet->position)) return BYTE_PACKET_NO_MEM;
+  std::memset(&(((char*)(packet->base_addr))[packet->position]),0,new_position - packet->position);
+  packet->position = new_position;
+  if(packet->position > packet->size_bytes) packet->size_bytes = packet->position;
+ }
+ return BYTE_PACKET_SUCCESS;
+}
@@ -8,9 +8,13 @@ Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
 #define BYTE_PACKET_H_
 
 #include <cstddef>
+#include <cstring>
 #include <cassert>
 
-#define BYTE_PACKET_CAPACITY 1048576 //default byte packet capacity in bytes
+#define BYTE_PACKET_CAPACITY 1048576 //default (initial) byte packet capacity in bytes
+
+#define BYTE_PACKET_SUCCESS 0 //success
+#define BYTE_PACKET_NO_MEM 1  //byte packet could not grow (memory allocation failure)
 
 //Byte packet (interoperable):
 typedef struct{
@@ -31,32 +35,95 @@ void clearBytePacket(BytePacket * packet);
 void resetBytePacket(BytePacket * packet,
                      unsigned long long new_position = 0);
 
+/** Grows the byte packet capacity to at least <min_capacity> bytes
+    (geometric growth). Returns false if the memory could not be obtained,
+    in which case the byte packet is left unchanged. **/
+bool growBytePacket(BytePacket * packet,
+                    unsigned long long min_capacity);
+
+/** Makes sure there are at least <num_bytes> bytes of capacity available
+    after the current packet position, growing the packet if needed.
+    Subsequent fillBytePacket() calls within the reserved space skip
+    all capacity checks (except in debug builds). **/
+inline bool reserveBytePacket(BytePacket * packet,
+                              unsigned long long num_bytes)
+{
+ if(packet->position + num_bytes <= packet->capacity) return true;
+ return growBytePacket(packet,packet->position + num_bytes);
+}
+
+/** Advances the packet position to the next multiple of <alignment> bytes
+    (power of two), zero-padding the skipped bytes. Used before bulk arrays
+    so that the packed data is suitably aligned for direct access.
+    The alignment is relative to the packet base address, which is what
+    survives packet growth (realloc may move the base) and transfer to
+    another process. Since the base address comes from malloc/realloc,
+    the absolute address is aligned as well for <alignment> not exceeding
+    alignof(std::max_align_t). Returns BYTE_PACKET_NO_MEM, with the packet
+    unchanged, if the packet could not grow. **/
+int alignBytePacket(BytePacket * packet,
+                    unsigned long long alignment);
+
 /** Appends an arbitrary plain old data variable at the current packet
-    position, shifting it forward by the size of the variable. **/
+    position, shifting it forward by the size of the variable.
+    The byte packet grows automatically if its capacity is exceeded.
+    Returns BYTE_PACKET_NO_MEM, with the packet unchanged, if it could not grow. **/
+template <typename T>
+int appendToBytePacket(BytePacket * packet, const T & item)
+{
+ if(!reserveBytePacket(packet,sizeof(T))) return BYTE_PACKET_NO_MEM;
+ std::memcpy(&(((char*)(packet->base_addr))[packet->position]),&item,sizeof(T));
+ packet->position += sizeof(T);
+ if(packet->position > packet->size_bytes) packet->size_bytes = packet->position;
+ return BYTE_PACKET_SUCCESS;
+}
+
+/** Appends a plain old data variable into the space previously reserved
+    by reserveBytePacket(), without any run-time capacity check. **/
 template <typename T>
-void appendToBytePacket(BytePacket * packet, const T & item)
+inline void fillBytePacket(BytePacket * packet, const T & item)
 {
- char * dst_ptr = &(((char*)(packet->base_addr))[packet->position]);
- const char * src_ptr = ((const char *)(&item));
- unsigned long long type_size = sizeof(T);
- assert(packet->position + type_size <= packet->capacity);
- for(unsigned long long i = 0; i < type_size; ++i) dst_ptr[i] = src_ptr[i];
- packet->position += type_size;
+ assert(packet->position + sizeof(T) <= packet->capacity);
+ std::memcpy(&(((char*)(packet->base_addr))[packet->position]),&item,sizeof(T));
+ packet->position += sizeof(T);
  if(packet->position > packet->size_bytes) packet->size_bytes = packet->position;
  return;
 }
 
+/** Appends an array of <num_items> plain old data variables at the current
+    packet position with a single bulk copy.
+    Returns BYTE_PACKET_NO_MEM, with the packet unchanged, if it could not grow. **/
+template <typename T>
+int appendArrayToBytePacket(BytePacket * packet, const T * items, unsigned long long num_items)
+{
+ unsigned long long num_bytes = sizeof(T) * num_items;
+ if(!reserveBytePacket(packet,num_bytes)) return BYTE_PACKET_NO_MEM;
+ if(num_bytes > 0) std::memcpy(&(((char*)(packet->base_addr))[packet->position]),items,num_bytes);
+ packet->position += num_bytes;
+ if(packet->position > packet->size_bytes) packet->size_bytes = packet->position;
+ return BYTE_PACKET_SUCCESS;
+}
+
 /** Extracts an arbitrary plain old data variable at the current packet
     position, shifting it forward by the size of the variable. **/
 template <typename T>
 void extractFromBytePacket(BytePacket * packet, T & item)
 {
- const char * src_ptr = &(((const char *)(packet->base_addr))[packet->position]);
- char * dst_ptr = ((char*)(&item));
- unsigned long long type_size = sizeof(T);
- assert(packet->position + type_size <= packet->size_bytes);
- for(unsigned long long i = 0; i < type_size; ++i) dst_ptr[i] = src_ptr[i];
- packet->position += type_size;
+ assert(packet->position + sizeof(T) <= packet->size_bytes);
+ std::memcpy(&item,&(((const char *)(packet->base_addr))[packet->position]),sizeof(T));
+ packet->position += sizeof(T);
+ return;
+}
+
+/** Extracts an array of <num_items> plain old data variables at the current
+    packet position with a single bulk copy. **/
+template <typename T>
+void extractArrayFromBytePacket(BytePacket * packet, T * items, unsigned long long num_items)
+{
+ unsigned long long num_bytes = sizeof(T) * num_items;
+ assert(packet->position + num_bytes <= packet->size_bytes);
+ if(num_bytes > 0) std::memcpy(items,&(((const char *)(packet->base_addr))[packet->position]),num_bytes);
+ packet->position += num_bytes;
  return;
 }
 
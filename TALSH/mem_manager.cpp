@@ -41,6 +41,8 @@ FOR DEVELOPERS ONLY:
 #include "tensor_algebra.h"
 #include "device_algebra.h"
 #include "mem_manager.h"
+#include "talsh_trace.h"
+#include "nvtx_profile.h"
 
 #define GPU_MEM_PART_USED 90         //percentage of free GPU global memory to be actually allocated for GPU argument buffers
 #define MEM_ALIGN GPU_CACHE_LINE_LEN //memory alignment (in bytes) for argument buffers
@@ -618,12 +620,15 @@ RETURN STATUS:
  err_code=0;
  ab_conf.buf_top=BLCK_BUF_TOP_HOST; ab_conf.buf_depth=BLCK_BUF_DEPTH_HOST; ab_conf.buf_branch=BLCK_BUF_BRANCH_HOST;
  //if(DEBUG) printf("\n#DEBUG(mem_manager:get_buf_entry_host): Allocating buffer entry for size %lu: ",bsize); //debug
+ prof_push("HostBufAlloc",4);
  err_code=get_buf_entry(ab_conf,bsize,arg_buf_host,abh_occ,abh_occ_size,blck_sizes_host,entry_ptr,entry_num);
+ prof_pop();
  //if(DEBUG) printf("Status %d: Buffer entry %d: Address %p\n",err_code,*entry_num,*entry_ptr); //debug
  if(err_code == 0){
   err_code=ab_get_2d_pos(ab_conf,*entry_num,&i,&j);
   if(err_code == 0){num_args_host++; occ_size_host+=blck_sizes_host[i]; args_size_host+=bsize;}
  }
+ if(err_code == 0 && talshTraceIsOn()) talshTraceCounter(TALSH_TRACE_CAT_MEM,"Host Buffer use",(double)occ_size_host);
  if(LOGGING && err_code == 0){
   printf("\n#DEBUG(TALSH:mem_manager): Host Buffer alloc %lu B -> Entry %d: Buffer use = %lu B\n",bsize,*entry_num,occ_size_host);
   fflush(stdout);
@@ -648,12 +653,15 @@ INPUT:
  err_code=0;
  ab_conf.buf_top=BLCK_BUF_TOP_HOST; ab_conf.buf_depth=BLCK_BUF_DEPTH_HOST; ab_conf.buf_branch=BLCK_BUF_BRANCH_HOST;
  //if(DEBUG) printf("\n#DEBUG(mem_manager:free_buf_entry_host): Deallocating buffer entry %d: ",entry_num); //debug
+ prof_push("HostBufFree",5);
  err_code=free_buf_entry(ab_conf,abh_occ,abh_occ_size,blck_sizes_host,entry_num);
+ prof_pop();
  //if(DEBUG) printf("Status %d\n",err_code); //debug
  if(err_code == 0){
   err_code=ab_get_2d_pos(ab_conf,entry_num,&i,&j);
   if(err_code == 0){num_args_host--; occ_size_host-=blck_sizes_host[i]; args_size_host=0;} //`args_size_host is not used (ignore it)
  }
+ if(err_code == 0 && talshTraceIsOn()) talshTraceCounter(TALSH_TRACE_CAT_MEM,"Host Buffer use",(double)occ_size_host);
  if(LOGGING && err_code == 0){
   printf("\n#DEBUG(TALSH:mem_manager): Host Buffer free -> Entry %d: Buffer use = %lu B\n",entry_num,occ_size_host);
   fflush(stdout);
@@ -681,6 +689,7 @@ RETURN STATUS:
 {
  int i,j,err_code;
  ab_conf_t ab_conf;
+ char cntr_name[TALSH_TRACE_NAME_LEN];
 
  omp_set_nest_lock(&mem_lock);
 #pragma omp flush
@@ -689,12 +698,18 @@ RETURN STATUS:
  if(gpu_num >= 0 && gpu_num < MAX_GPUS_PER_NODE){
   if(gpu_is_mine(gpu_num) != 0){
    ab_conf.buf_top=BLCK_BUF_TOP_GPU; ab_conf.buf_depth=BLCK_BUF_DEPTH_GPU; ab_conf.buf_branch=BLCK_BUF_BRANCH_GPU;
+   prof_push("GPUBufAlloc",4);
    err_code=get_buf_entry(ab_conf,bsize,arg_buf_gpu[gpu_num],abg_occ[gpu_num],abg_occ_size[gpu_num],&blck_sizes_gpu[gpu_num][0],entry_ptr,entry_num);
+   prof_pop();
 // if(err_code == 0 && DEBUG != 0) printf("\n#DEBUG(mem_manager:get_buf_entry_gpu): Entry allocated: %d %d %p\n",gpu_num,*entry_num,*entry_ptr); //debug
    if(err_code == 0){
     err_code=ab_get_2d_pos(ab_conf,*entry_num,&i,&j);
     if(err_code == 0){num_args_gpu[gpu_num]++; occ_size_gpu[gpu_num]+=blck_sizes_gpu[gpu_num][i]; args_size_gpu[gpu_num]+=bsize;}
    }
+   if(err_code == 0 && talshTraceIsOn()){
+    snprintf(cntr_name,TALSH_TRACE_NAME_LEN,"GPU %d Buffer use",gpu_num);
+    talshTraceCounter(TALSH_TRACE_CAT_MEM,cntr_name,(double)occ_size_gpu[gpu_num]);
+   }
    if(LOGGING && err_code == 0){
     printf("\n#DEBUG(TALSH:mem_manager): GPU %d Buffer alloc %lu B -> Entry %d: Buffer use = %lu B\n",gpu_num,bsize,*entry_num,occ_size_gpu[gpu_num]);
     fflush(stdout);
@@ -719,6 +734,7 @@ INPUT:
 {
  int i,j,err_code;
  ab_conf_t ab_conf;
+ char cntr_name[TALSH_TRACE_NAME_LEN];
 
  omp_set_nest_lock(&mem_lock);
 #pragma omp flush
@@ -727,12 +743,18 @@ INPUT:
  if(gpu_num >= 0 && gpu_num < MAX_GPUS_PER_NODE){
   if(gpu_is_mine(gpu_num) != 0){
    ab_conf.buf_top=BLCK_BUF_TOP_GPU; ab_conf.buf_depth=BLCK_BUF_DEPTH_GPU; ab_conf.buf_branch=BLCK_BUF_BRANCH_GPU;
+   prof_push("GPUBufFree",5);
    err_code=free_buf_entry(ab_conf,abg_occ[gpu_num],abg_occ_size[gpu_num],&blck_sizes_gpu[gpu_num][0],entry_num);
+   prof_pop();
 // if(err_code == 0 && DEBUG != 0) printf("\n#DEBUG(mem_manager:free_buf_entry_gpu): Entry deallocated: %d %d\n",gpu_num,entry_num); //debug
    if(err_code == 0){
     err_code=ab_get_2d_pos(ab_conf,entry_num,&i,&j);
     if(err_code == 0){num_args_gpu[gpu_num]--; occ_size_gpu[gpu_num]-=blck_sizes_gpu[gpu_num][i]; args_size_gpu[gpu_num]=0;} //`args_size_gpu is not used here (ignore it)
    }
+   if(err_code == 0 && talshTraceIsOn()){
+    snprintf(cntr_name,TALSH_TRACE_NAME_LEN,"GPU %d Buffer use",gpu_num);
+    talshTraceCounter(TALSH_TRACE_CAT_MEM,cntr_name,(double)occ_size_gpu[gpu_num]);
+   }
    if(LOGGING && err_code == 0){
     printf("\n#DEBUG(TALSH:mem_manager): GPU %d Buffer free -> Entry %d: Buffer use = %lu B\n",gpu_num,entry_num,occ_size_gpu[gpu_num]);
     fflush(stdout);
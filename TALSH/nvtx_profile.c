@@ -1,13 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+
+#ifdef USE_ITT
+#include "ittnotify.h"
+#endif
+
 #include "nvtx_profile.h"
 
+#define PROF_MAX_REGIONS 512 //max number of distinct profiled regions (power of 2)
+#define PROF_MAX_DEPTH 64    //max nesting depth of profiled regions per thread
+#define PROF_NAME_LEN 48     //max region name length (including the terminating null): longer names are truncated
+
+//Profiled region (timer aggregator):
+typedef struct{
+ char name[PROF_NAME_LEN]; //region name (empty: unused entry)
+ long long calls;          //number of times the region has been closed
+ double time_incl;         //inclusive time (sec)
+ double time_excl;         //exclusive time (sec): inclusive minus time spent in nested regions
+} prof_region_t;
+
+static int prof_backend = -1; //active backend (-1: not initialized yet)
+static prof_region_t prof_regions[PROF_MAX_REGIONS]; //region table (hashed by name)
+//Per-thread stack of open regions (timer aggregator):
+static int prof_depth = 0;
+static int prof_stack_region[PROF_MAX_DEPTH];
+static double prof_stack_start[PROF_MAX_DEPTH];
+static double prof_stack_child[PROF_MAX_DEPTH];
+#pragma omp threadprivate(prof_depth,prof_stack_region,prof_stack_start,prof_stack_child)
+#ifdef USE_ITT
+static __itt_domain * prof_itt_domain = NULL;
+#endif
+
+static void prof_init()
+/** Sets the default backend or the one requested via the environment variable TALSH_PROFILER. **/
+{
+ int backend;
+ const char * env;
+
+#ifndef NO_GPU
+ backend=PROF_BACKEND_NVTX;
+#else
+ backend=PROF_BACKEND_NONE;
+#endif
+ env=getenv("TALSH_PROFILER");
+ if(env != NULL){
+  if(strcmp(env,"none") == 0){backend=PROF_BACKEND_NONE;}
+  else if(strcmp(env,"timer") == 0){backend=PROF_BACKEND_TIMER;}
+  else if(strcmp(env,"itt") == 0){backend=PROF_BACKEND_ITT;}
+  else if(strcmp(env,"nvtx") == 0){backend=PROF_BACKEND_NVTX;}
+ }
+#pragma omp critical (prof_table)
+ {
+  if(prof_backend < 0){
+   if(prof_set_backend(backend) != 0) prof_backend=PROF_BACKEND_NONE;
+  }
+ }
+ return;
+}
+
+static int prof_region_find(const char * name)
+/** Returns the region table entry for a given region name (a new entry is created if needed),
+    or -1 if the region table is full. **/
+{
+ int i,k,n;
+ unsigned int h;
+
+ h=5381u; for(i=0; i < PROF_NAME_LEN-1 && name[i] != '\0'; ++i) h=h*33u+(unsigned int)((unsigned char)name[i]);
+ n=-1;
+#pragma omp critical (prof_table)
+ {
+  for(i=0; i < PROF_MAX_REGIONS; ++i){
+   k=(int)((h+(unsigned int)i)&(PROF_MAX_REGIONS-1));
+   if(prof_regions[k].name[0] == '\0'){ //new region
+    strncpy(prof_regions[k].name,name,PROF_NAME_LEN-1); prof_regions[k].name[PROF_NAME_LEN-1]='\0';
+    prof_regions[k].calls=0; prof_regions[k].time_incl=0.0; prof_regions[k].time_excl=0.0;
+    n=k; break;
+   }
+   if(strncmp(prof_regions[k].name,name,PROF_NAME_LEN-1) == 0){n=k; break;}
+  }
+ }
+ return n;
+}
+
+int prof_set_backend(int backend)
+{
+ int errc=0;
+
+ switch(backend){
+ case PROF_BACKEND_NONE:
+ case PROF_BACKEND_TIMER:
+  break;
+ case PROF_BACKEND_ITT:
+#ifdef USE_ITT
+  if(prof_itt_domain == NULL) prof_itt_domain=__itt_domain_create("ExaTENSOR");
+  if(prof_itt_domain == NULL) errc=1;
+#else
+  errc=1;
+#endif
+  break;
+ case PROF_BACKEND_NVTX:
+#ifdef NO_GPU
+  errc=1;
+#endif
+  break;
+ default:
+  errc=1;
+ }
+ if(errc == 0) prof_backend=backend;
+ return errc;
+}
+
+int prof_get_backend()
+{
+ if(prof_backend < 0) prof_init();
+ return prof_backend;
+}
+
 void prof_push(const char * annotation, int color)
 {
- PUSH_RANGE(annotation,color)
+ (void)color; /* only used by the NVTX backend */
+ if(prof_backend < 0) prof_init();
+ switch(prof_backend){
+ case PROF_BACKEND_TIMER:
+  if(prof_depth < PROF_MAX_DEPTH){
+   prof_stack_region[prof_depth]=prof_region_find(annotation);
+   prof_stack_child[prof_depth]=0.0;
+   prof_stack_start[prof_depth]=omp_get_wtime();
+  }
+  ++prof_depth;
+  break;
+ case PROF_BACKEND_ITT:
+#ifdef USE_ITT
+  __itt_task_begin(prof_itt_domain,__itt_null,__itt_null,__itt_string_handle_create(annotation));
+#endif
+  break;
+ case PROF_BACKEND_NVTX:
+  PUSH_RANGE(annotation,color)
+  break;
+ }
  return;
 }
 
 void prof_pop()
 {
- POP_RANGE
+ int n;
+ double tm;
+
+ switch(prof_backend){
+ case PROF_BACKEND_TIMER:
+  if(prof_depth > 0){
+   --prof_depth;
+   if(prof_depth < PROF_MAX_DEPTH){
+    tm=omp_get_wtime()-prof_stack_start[prof_depth];
+    if(prof_depth > 0) prof_stack_child[prof_depth-1]+=tm;
+    n=prof_stack_region[prof_depth];
+    if(n >= 0){
+#pragma omp atomic update
+     prof_regions[n].calls+=1;
+#pragma omp atomic update
+     prof_regions[n].time_incl+=tm;
+#pragma omp atomic update
+     prof_regions[n].time_excl+=(tm-prof_stack_child[prof_depth]);
+    }
+   }
+  }
+  break;
+ case PROF_BACKEND_ITT:
+#ifdef USE_ITT
+  __itt_task_end(prof_itt_domain);
+#endif
+  break;
+ case PROF_BACKEND_NVTX:
+  POP_RANGE
+  break;
+ }
+ return;
+}
+
+void prof_reset()
+{
+#pragma omp critical (prof_table)
+ {
+  memset(prof_regions,0,sizeof(prof_regions));
+ }
+ return;
+}
+
+void prof_report()
+/** Prints the profiled regions ordered by their inclusive time. **/
+{
+ int i,j,k,n;
+ int order[PROF_MAX_REGIONS];
+
+#pragma omp critical (prof_table)
+ {
+  n=0;
+  for(i=0; i < PROF_MAX_REGIONS; ++i){
+   if(prof_regions[i].name[0] != '\0'){
+    k=i; j=n++;
+    while(j > 0 && prof_regions[order[j-1]].time_incl < prof_regions[k].time_incl){order[j]=order[j-1]; --j;}
+    order[j]=k;
+   }
+  }
+  printf("\n#MSG(PROFILER): Profiled regions (time in sec):\n");
+  printf(" %-*s %12s %14s %14s\n",PROF_NAME_LEN-1,"Region","Calls","Inclusive","Exclusive");
+  for(i=0; i < n; ++i){
+   k=order[i];
+   printf(" %-*s %12lld %14.6f %14.6f\n",PROF_NAME_LEN-1,prof_regions[k].name,
+          prof_regions[k].calls,prof_regions[k].time_incl,prof_regions[k].time_excl);
+  }
+  printf("#END_MSG\n");
+  fflush(stdout);
+ }
  return;
 }
@@ -1,5 +1,18 @@
 /* https://devblogs.nvidia.com/cuda-pro-tip-generate-custom-application-profile-timelines-nvtx */
 
+/* Profiling hooks (prof_push/prof_pop) with pluggable backends:
+ # PROF_BACKEND_NONE: Hooks are no-ops;
+ # PROF_BACKEND_TIMER: Built-in timer aggregator (calls, inclusive and exclusive time per region),
+                       the region table is printed by prof_report();
+ # PROF_BACKEND_ITT: ITT task markers (Intel VTune, perf with ITT collector), requires -DUSE_ITT;
+ # PROF_BACKEND_NVTX: NVIDIA NVTX ranges, requires a GPU build (no -DNO_GPU).
+ The default backend is NVTX in GPU builds and NONE otherwise. It can be
+ changed by prof_set_backend() or by the environment variable TALSH_PROFILER
+ set to one of {none|timer|itt|nvtx}, which is read on the first hook call.
+ Regions must be properly nested within each thread.
+ This header and nvtx_profile.c are the only copy: DDSS builds its nvtx_profile.o
+ from the TAL-SH source, so both objects merged into libexatensor are the same. */
+
 #ifndef NVTX_PROFILE_H_
 #define NVTX_PROFILE_H_
 
@@ -32,12 +45,21 @@ const int num_colors = sizeof(colors)/sizeof(uint32_t);
 
 #endif //NO_GPU
 
+//Profiling backends:
+#define PROF_BACKEND_NONE 0
+#define PROF_BACKEND_TIMER 1
+#define PROF_BACKEND_ITT 2
+#define PROF_BACKEND_NVTX 3
 
 #ifdef __cplusplus
 extern "C" {
 #endif
- void prof_push(const char * annotation, int color);
- void prof_pop();
+ void prof_push(const char * annotation, int color); //opens a profiled region (the color is only used by NVTX)
+ void prof_pop();                                    //closes the most recently opened region on the calling thread
+ int prof_set_backend(int backend);                  //selects the profiling backend (0:success, 1:backend not available)
+ int prof_get_backend();                             //returns the active profiling backend
+ void prof_reset();                                  //clears the timer aggregator region table
+ void prof_report();                                 //prints the timer aggregator region table (stdout)
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,8 @@ along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
 
 #include <math.h>
 #include "timer.h"
+#include "talsh_trace.h"
+#include "talsh_half.h"
 
 #include "tensor_algebra.h"
 
@@ -101,7 +103,7 @@ along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
 typedef struct{
  talsh_tens_shape_t * shape_p; //shape of the tensor block
  talsh_dev_rsc_t * dev_rsc;    //list of device resources occupied by the tensor block body on each device
- int * data_kind;              //list of data kinds for each device location occupied by the tensor body {R4,R8,C4,C8}
+ int * data_kind;              //list of data kinds for each device location occupied by the tensor body {R2,RB2,R4,R8,C4,C8}
  int * avail;                  //list of the data availability flags for each device location occupied by the tensor body
  int dev_rsc_len;              //capacity of .dev_rsc[], .data_kind[], .avail[]
  int ndev;                     //number of devices the tensor block body resides on: ndev <= dev_rsc_len
@@ -253,7 +255,7 @@ extern "C"{
                           double init_val_imag = 0.0);
  int talshTensorConstruct_(talsh_tens_t * tens_block, int data_kind, int tens_rank, const int tens_dims[], int dev_id,
                            void * ext_mem, int in_hab, talsh_tens_init_i init_method, double init_val_real, double init_val_imag);
-//  Import external data for the tensor body:
+//  Import external data for the tensor body (converted into the data kind of the Host tensor body image, if different):
  int talshTensorImportData(talsh_tens_t * tens_block,
                            int data_kind,
                            const void * ext_data);
@@ -361,7 +363,7 @@ extern "C"{
  int talshTasksWait(int ntasks,
                     talsh_task_t talsh_tasks[],
                     int stats[]);
-//  Get the TAL-SH task timings:
+//  Get the TAL-SH task timings (on Host, the phase timings are only available for tensor contractions):
  int talshTaskTime(talsh_task_t * talsh_task,
                    double * total,
                    double * comput = NULL,
@@ -469,9 +471,11 @@ extern "C"{
                       int dev_kind = DEV_DEFAULT,            //in: device kind (if present, <dev_id> is kind-specific)
                       int copy_ctrl = COPY_MT,               //in: copy control (COPY_XX), defaults to COPY_MT
                       int accumulative = NOPE,               //in: accumulate in VS overwrite destination tensor: [YEP|NOPE]
-                      talsh_task_t * talsh_task = NULL);     //inout: TAL-SH task handle
+                      talsh_task_t * talsh_task = NULL,      //inout: TAL-SH task handle
+                      const int * permutation = NULL);       //in: O2N index permutation (1-based): dimension i of <ltens> is dimension permutation[i] of <dtens> (Host only)
  int talshTensorSlice_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * offsets,
-                       int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+                       int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task,
+                       const int * permutation);
 //  Tensor insertion:
  int talshTensorInsert(talsh_tens_t * dtens,                  //inout: destination tensor block
                        talsh_tens_t * ltens,                  //inout: source tensor block (tensor slice)
@@ -480,9 +484,11 @@ extern "C"{
                        int dev_kind = DEV_DEFAULT,            //in: device kind (if present, <dev_id> is kind-specific)
                        int copy_ctrl = COPY_MT,               //in: copy control (COPY_XX), defaults to COPY_MT
                        int accumulative = NOPE,               //in: accumulate in VS overwrite destination tensor: [YEP|NOPE]
-                       talsh_task_t * talsh_task = NULL);     //inout: TAL-SH task handle
+                       talsh_task_t * talsh_task = NULL,      //inout: TAL-SH task handle
+                       const int * permutation = NULL);       //in: O2N index permutation (1-based): dimension i of <ltens> is dimension permutation[i] of <dtens> (Host only)
  int talshTensorInsert_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * offsets,
-                        int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+                        int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task,
+                        const int * permutation);
 //  Tensor copy (with an optional permutation of indices):
  int talshTensorCopy(const char * cptrn,                    //in: C-string: symbolic copy pattern, e.g. "D(a,b,c,d)=L(c,d,b,a)"
                      talsh_tens_t * dtens,                  //inout: destination tensor block
@@ -516,10 +522,39 @@ extern "C"{
                          int dev_kind = DEV_DEFAULT,        //in: device kind (if present, <dev_id> is kind-specific)
                          int copy_ctrl = COPY_MTT,          //in: copy control (COPY_XXX), defaults to COPY_MTT
                          int accumulative = YEP,            //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
-                         talsh_task_t * talsh_task = NULL); //inout: TAL-SH task (must be clean)
+                         talsh_task_t * talsh_task = NULL,  //inout: TAL-SH task (must be clean)
+                         int math_mode = CONTR_MATH_DEFAULT); //in: Host arithmetic mode for R8/C8 data (CONTR_MATH_XXX), ignored by accelerators
  int talshTensorContract_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
                           double scale_real, double scale_imag, int dev_id, int dev_kind,
-                          int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+                          int copy_ctrl, int accumulative, talsh_task_t * talsh_task, int math_mode);
+//  Tensor product (Hadamard, Khatri-Rao, Kronecker: every index of each input tensor appears in the destination tensor):
+ int talshTensorProduct(const char * cptrn,                //in: C-string: symbolic tensor product pattern, e.g. "D(a,b,c)+=L(a,b)*R(a,c)"
+                        talsh_tens_t * dtens,              //inout: destination tensor block
+                        talsh_tens_t * ltens,              //inout: left source tensor block
+                        talsh_tens_t * rtens,              //inout: right source tensor block
+                        double scale_real = 1.0,           //in: scaling value (real part), defaults to 1
+                        double scale_imag = 0.0,           //in: scaling value (imaginary part), defaults to 0
+                        int dev_id = DEV_DEFAULT,          //in: device id (flat or kind-specific), Host only for now
+                        int dev_kind = DEV_DEFAULT,        //in: device kind (if present, <dev_id> is kind-specific)
+                        int copy_ctrl = COPY_MTT,          //in: copy control (COPY_XXX), defaults to COPY_MTT
+                        int accumulative = YEP,            //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                        talsh_task_t * talsh_task = NULL); //inout: TAL-SH task (must be clean)
+ int talshTensorProduct_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
+                         double scale_real, double scale_imag, int dev_id, int dev_kind,
+                         int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+//  Tensor trace (partial or full: each destination index appears once, each other index twice in the source tensor):
+ int talshTensorTrace(const char * cptrn,                  //in: C-string: symbolic tensor trace pattern, e.g. "D(a,b)+=L(a,i,b,i)"
+                      talsh_tens_t * dtens,                //inout: destination tensor block
+                      talsh_tens_t * ltens,                //inout: source tensor block
+                      double scale_real = 1.0,             //in: scaling value (real part), defaults to 1
+                      double scale_imag = 0.0,             //in: scaling value (imaginary part), defaults to 0
+                      int dev_id = DEV_DEFAULT,            //in: device id (flat or kind-specific), Host only for now
+                      int dev_kind = DEV_DEFAULT,          //in: device kind (if present, <dev_id> is kind-specific)
+                      int copy_ctrl = COPY_MT,             //in: copy control (COPY_XX), defaults to COPY_MT
+                      int accumulative = YEP,              //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                      talsh_task_t * talsh_task = NULL);   //inout: TAL-SH task (must be clean)
+ int talshTensorTrace_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, double scale_real, double scale_imag,
+                       int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
 //  Tensor contraction (extra large):
  int talshTensorContractXL(const char * cptrn,          //in: C-string: symbolic contraction pattern, e.g. "D(a,b,c,d)+=L(c,i,j,a)*R(b,j,d,i)"
                            talsh_tens_t * dtens,        //inout: destination tensor block
@@ -0,0 +1,258 @@
+/** ExaTensor::TAL-SH: Reduced-precision (16-bit) floating point storage and data conversions.
+AUTHOR: Dmitry I. Lyakh (Liakh): quant4me@gmail.com
+REVISION: 2020/05/12
+
+Copyright (C) 2014-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+This file is part of ExaTensor.
+
+ExaTensor is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ExaTensor is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "talsh_complex.h"
+#include "talsh.h"
+#include "talsh_half.h"
+
+#define HALF_CONV_CHUNK 4096 //number of elements converted by a thread at a time (multiple of 16)
+
+//LOCAL (PRIVATE) FUNCTION PROTOTYPES:
+static inline uint32_t f32_bits(float val);
+static inline float bits_f32(uint32_t bits);
+static void half_from_float(talshFloat16 * dst, const float * src, size_t n);
+static void half_to_float(float * dst, const talshFloat16 * src, size_t n);
+static void bhalf_from_float(talshBFloat16 * dst, const float * src, size_t n);
+static void bhalf_to_float(float * dst, const talshBFloat16 * src, size_t n);
+static int real_to_float(float * dst, int src_kind, const void * src, size_t n);
+static int float_to_real(int dst_kind, void * dst, const float * src, size_t n);
+
+//FUNCTION DEFINITIONS:
+static inline uint32_t f32_bits(float val)
+{
+ uint32_t bits;
+ memcpy(&bits,&val,sizeof(bits));
+ return bits;
+}
+
+static inline float bits_f32(uint32_t bits)
+{
+ float val;
+ memcpy(&val,&bits,sizeof(val));
+ return val;
+}
+
+talshFloat16 talshFloat16Set(float val)
+/** Converts FP32 to binary16 (round-to-nearest-even, overflow to infinity, gradual underflow). **/
+{
+ uint32_t x = f32_bits(val);
+ uint32_t sign = (x>>16)&0x8000u;
+ uint32_t absx = x&0x7FFFFFFFu;
+ uint32_t h,m,rem,half;
+ int shift;
+
+ if(absx > 0x7F800000u) return (talshFloat16)(sign|0x7E00u|((absx>>13)&0x03FFu)); //NaN (quiet)
+ if(absx >= 0x47800000u) return (talshFloat16)(sign|0x7C00u); //overflow or infinity
+ if(absx < 0x38800000u){ //binary16 subnormal or zero
+  if(absx <= 0x33000000u) return (talshFloat16)sign; //below half of the smallest subnormal (ties to even zero)
+  m=(absx&0x007FFFFFu)|0x00800000u; shift=126-(int)(absx>>23);
+  h=m>>shift; rem=m&((1u<<shift)-1u); half=1u<<(shift-1);
+  if(rem > half || (rem == half && (h&1u))) ++h;
+  return (talshFloat16)(sign|h);
+ }
+ h=(absx-0x38000000u)>>13; rem=absx&0x1FFFu; //exponent rebias (127-15)
+ if(rem > 0x1000u || (rem == 0x1000u && (h&1u))) ++h; //mantissa carry may propagate into the exponent (up to infinity)
+ return (talshFloat16)(sign|h);
+}
+
+float talshFloat16Get(talshFloat16 val)
+/** Converts binary16 to FP32 (exact). **/
+{
+ uint32_t sign = ((uint32_t)(val&0x8000u))<<16;
+ uint32_t e = (val>>10)&0x1Fu;
+ uint32_t m = val&0x03FFu;
+
+ if(e == 0){
+  if(m == 0) return bits_f32(sign); //signed zero
+  e=113; while((m&0x0400u) == 0){m<<=1; --e;} m&=0x03FFu; //normalize a subnormal
+  return bits_f32(sign|(e<<23)|(m<<13));
+ }
+ if(e == 31) return bits_f32(sign|0x7F800000u|(m<<13)); //infinity or NaN
+ return bits_f32(sign|((e+112u)<<23)|(m<<13));
+}
+
+talshBFloat16 talshBFloat16Set(float val)
+/** Converts FP32 to bfloat16 (round-to-nearest-even). **/
+{
+ uint32_t x = f32_bits(val);
+ if((x&0x7FFFFFFFu) > 0x7F800000u) return (talshBFloat16)((x>>16)|0x0040u); //NaN (quiet)
+ x+=0x7FFFu+((x>>16)&1u);
+ return (talshBFloat16)(x>>16);
+}
+
+float talshBFloat16Get(talshBFloat16 val)
+/** Converts bfloat16 to FP32 (exact). **/
+{
+ return bits_f32(((uint32_t)val)<<16);
+}
+
+static void half_from_float(talshFloat16 * dst, const float * src, size_t n)
+{
+ size_t l = 0;
+#ifdef __F16C__
+ for(; l+8 <= n; l+=8){
+  _mm_storeu_si128((__m128i*)(&dst[l]),_mm256_cvtps_ph(_mm256_loadu_ps(&src[l]),_MM_FROUND_TO_NEAREST_INT));
+ }
+#endif
+ for(; l < n; ++l) dst[l]=talshFloat16Set(src[l]);
+ return;
+}
+
+static void half_to_float(float * dst, const talshFloat16 * src, size_t n)
+{
+ size_t l = 0;
+#ifdef __F16C__
+ for(; l+8 <= n; l+=8){
+  _mm256_storeu_ps(&dst[l],_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(&src[l]))));
+ }
+#endif
+ for(; l < n; ++l) dst[l]=talshFloat16Get(src[l]);
+ return;
+}
+
+static void bhalf_from_float(talshBFloat16 * dst, const float * src, size_t n)
+{
+ size_t l = 0;
+#ifdef __AVX512BF16__
+ for(; l+16 <= n; l+=16){
+  __m256bh bh = _mm512_cvtneps_pbh(_mm512_loadu_ps(&src[l]));
+  memcpy(&dst[l],&bh,sizeof(bh));
+ }
+#endif
+#pragma omp simd
+ for(size_t i = l; i < n; ++i) dst[i]=talshBFloat16Set(src[i]);
+ return;
+}
+
+static void bhalf_to_float(float * dst, const talshBFloat16 * src, size_t n)
+{
+ size_t l = 0;
+#ifdef __AVX512F__
+ for(; l+16 <= n; l+=16){
+  __m512i w = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(&src[l])));
+  _mm512_storeu_si512((void*)(&dst[l]),_mm512_slli_epi32(w,16));
+ }
+#endif
+#pragma omp simd
+ for(size_t i = l; i < n; ++i) dst[i]=talshBFloat16Get(src[i]);
+ return;
+}
+
+static int real_to_float(float * dst, int src_kind, const void * src, size_t n)
+/** Converts a chunk of real data into FP32. **/
+{
+ const double * r8p;
+
+ switch(src_kind){
+  case R2: half_to_float(dst,(const talshFloat16*)src,n); break;
+  case RB2: bhalf_to_float(dst,(const talshBFloat16*)src,n); break;
+  case R4: memcpy(dst,src,n*sizeof(float)); break;
+  case R8: r8p=(const double*)src; for(size_t l = 0; l < n; ++l) dst[l]=(float)(r8p[l]); break;
+  default: return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+static int float_to_real(int dst_kind, void * dst, const float * src, size_t n)
+/** Converts a chunk of FP32 data into real data. **/
+{
+ double * r8p;
+
+ switch(dst_kind){
+  case R2: half_from_float((talshFloat16*)dst,src,n); break;
+  case RB2: bhalf_from_float((talshBFloat16*)dst,src,n); break;
+  case R4: memcpy(dst,src,n*sizeof(float)); break;
+  case R8: r8p=(double*)dst; for(size_t l = 0; l < n; ++l) r8p[l]=(double)(src[l]); break;
+  default: return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+int talsh_data_convert(int dst_kind, void * dst, int src_kind, const void * src, size_t vol)
+/** Converts data between data kinds. Conversions involving R2/RB2 go through FP32
+    (R8 data are rounded to FP32 first), processed in chunks by all threads. **/
+{
+ int errc,dks,dkd;
+ size_t nchunks;
+ const talshComplex4 * c4s;
+ const talshComplex8 * c8s;
+ talshComplex4 * c4d;
+ talshComplex8 * c8d;
+
+ if(vol == 0) return TALSH_SUCCESS;
+ if(dst == NULL || src == NULL) return TALSH_INVALID_ARGS;
+ if(tens_valid_data_kind(src_kind,&dks) != YEP || tens_valid_data_kind(dst_kind,&dkd) != YEP) return TALSH_INVALID_ARGS;
+ if(src_kind == NO_TYPE || dst_kind == NO_TYPE) return TALSH_INVALID_ARGS;
+ errc=TALSH_SUCCESS;
+ if(src_kind == dst_kind){ //plain copy
+  nchunks=(vol*dks+HALF_CONV_CHUNK-1)/HALF_CONV_CHUNK;
+#pragma omp parallel for schedule(static)
+  for(size_t k = 0; k < nchunks; ++k){
+   size_t b = k*HALF_CONV_CHUNK; size_t e = b+HALF_CONV_CHUNK; if(e > vol*dks) e=vol*dks;
+   memcpy(&(((char*)dst)[b]),&(((const char*)src)[b]),e-b);
+  }
+ }else if(src_kind == C4 && dst_kind == C8){
+  c4s=(const talshComplex4*)src; c8d=(talshComplex8*)dst;
+#pragma omp parallel for schedule(static)
+  for(size_t l = 0; l < vol; ++l) c8d[l]=talshComplex8Set((double)talshComplex4Real(c4s[l]),(double)talshComplex4Imag(c4s[l]));
+ }else if(src_kind == C8 && dst_kind == C4){
+  c8s=(const talshComplex8*)src; c4d=(talshComplex4*)dst;
+#pragma omp parallel for schedule(static)
+  for(size_t l = 0; l < vol; ++l) c4d[l]=talshComplex4Set((float)talshComplex8Real(c8s[l]),(float)talshComplex8Imag(c8s[l]));
+ }else if(src_kind == R4){ //direct FP32 source
+  nchunks=(vol+HALF_CONV_CHUNK-1)/HALF_CONV_CHUNK;
+#pragma omp parallel for schedule(static) reduction(max:errc)
+  for(size_t k = 0; k < nchunks; ++k){
+   size_t b = k*HALF_CONV_CHUNK; size_t n = vol-b; if(n > HALF_CONV_CHUNK) n=HALF_CONV_CHUNK;
+   int ierr = float_to_real(dst_kind,&(((char*)dst)[b*dkd]),&(((const float*)src)[b]),n);
+   if(ierr != TALSH_SUCCESS) errc=TALSH_INVALID_ARGS;
+  }
+ }else if(dst_kind == R4){ //direct FP32 destination
+  nchunks=(vol+HALF_CONV_CHUNK-1)/HALF_CONV_CHUNK;
+#pragma omp parallel for schedule(static) reduction(max:errc)
+  for(size_t k = 0; k < nchunks; ++k){
+   size_t b = k*HALF_CONV_CHUNK; size_t n = vol-b; if(n > HALF_CONV_CHUNK) n=HALF_CONV_CHUNK;
+   int ierr = real_to_float(&(((float*)dst)[b]),src_kind,&(((const char*)src)[b*dks]),n);
+   if(ierr != TALSH_SUCCESS) errc=TALSH_INVALID_ARGS;
+  }
+ }else{ //real to real through an FP32 chunk buffer
+  nchunks=(vol+HALF_CONV_CHUNK-1)/HALF_CONV_CHUNK;
+#pragma omp parallel for schedule(static) reduction(max:errc)
+  for(size_t k = 0; k < nchunks; ++k){
+   float buf[HALF_CONV_CHUNK];
+   size_t b = k*HALF_CONV_CHUNK; size_t n = vol-b; if(n > HALF_CONV_CHUNK) n=HALF_CONV_CHUNK;
+   int ierr = real_to_float(buf,src_kind,&(((const char*)src)[b*dks]),n);
+   if(ierr == TALSH_SUCCESS) ierr=float_to_real(dst_kind,&(((char*)dst)[b*dkd]),buf,n);
+   if(ierr != TALSH_SUCCESS) errc=TALSH_INVALID_ARGS;
+  }
+ }
+ return errc;
+}
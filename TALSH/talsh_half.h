@@ -0,0 +1,69 @@
+/** ExaTensor::TAL-SH: Reduced-precision (16-bit) floating point storage and data conversions.
+AUTHOR: Dmitry I. Lyakh (Liakh): quant4me@gmail.com
+REVISION: 2020/05/12
+
+Copyright (C) 2014-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+This file is part of ExaTensor.
+
+ExaTensor is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ExaTensor is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------------
+NOTES:
+ # Data kinds R2 (IEEE 754 binary16) and RB2 (bfloat16) are storage-only data kinds:
+   A tensor body image of these kinds occupies 2 bytes per element. Host tensor
+   operations convert the operands into temporary R4 working copies, execute
+   the regular R4 kernels (FP32 arithmetic and accumulation), and convert
+   the destination tensor back (round-to-nearest-even).
+ # Vectorized conversions are used when the compiler targets the corresponding
+   instruction set extension (e.g., -march=native): F16C for R2, AVX-512 BF16
+   (AVX-512F for widening) for RB2. Otherwise portable bitwise conversions are used.
+   The AVX-512 BF16 narrowing instruction flushes denormal inputs to zero.
+ # Accelerators do not support R2/RB2 tensor operations.
+**/
+
+#ifndef TALSH_HALF_H_
+#define TALSH_HALF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+//16-bit floating point storage (raw bits):
+typedef uint16_t talshFloat16;  //IEEE 754 binary16: 1 sign bit, 5 exponent bits, 10 mantissa bits
+typedef uint16_t talshBFloat16; //bfloat16: 1 sign bit, 8 exponent bits, 7 mantissa bits
+
+#ifdef __cplusplus
+namespace talsh{
+//C++ storage types (distinct types for the data kind traits):
+struct Float16{talshFloat16 bits;};   //R2 tensor element
+struct BFloat16{talshBFloat16 bits;}; //RB2 tensor element
+} //namespace talsh
+#endif
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+//Scalar conversions:
+ talshFloat16 talshFloat16Set(float val);
+ float talshFloat16Get(talshFloat16 val);
+ talshBFloat16 talshBFloat16Set(float val);
+ float talshBFloat16Get(talshBFloat16 val);
+//Convert <vol> elements of data kind <src_kind> into data kind <dst_kind> (arrays must not overlap):
+// Supported conversions: Any pair from {R2,RB2,R4,R8}, any pair from {C4,C8}.
+ int talsh_data_convert(int dst_kind, void * dst, int src_kind, const void * src, size_t vol);
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TALSH_HALF_H_
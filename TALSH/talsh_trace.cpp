@@ -0,0 +1,266 @@
+/** ExaTensor::TAL-SH: Low-overhead event tracer (ring buffer) with Chrome trace export.
+AUTHOR: Dmitry I. Lyakh (Liakh): quant4me@gmail.com
+REVISION: 2020/05/07
+
+Copyright (C) 2014-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+This file is part of ExaTensor.
+
+ExaTensor is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ExaTensor is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include "timer.h"
+#include "talsh.h"
+#include "talsh_trace.h"
+
+//Trace event kinds:
+#define TRACE_EVENT_COMPLETE 'X' //complete event (begin and end time stamps on the same thread)
+#define TRACE_EVENT_ASYNC 'b'    //asynchronous event (begin and end time stamps associated with an id)
+#define TRACE_EVENT_COUNTER 'C'  //counter value
+
+//Trace event record (binary):
+typedef struct{
+ double time_begin;              //begin time stamp (sec)
+ double time_end;                //end time stamp (sec)
+ double value;                   //counter value
+ long long arg;                  //event argument or asynchronous id
+ int thread;                     //thread id (internal numeration)
+ char kind;                      //event kind (TRACE_EVENT_XXX)
+ char category;                  //event category (TALSH_TRACE_CAT_XXX)
+ char name[TALSH_TRACE_NAME_LEN]; //event name (null-terminated)
+} trace_event_t;
+
+//MODULE DATA:
+static const char * trace_cat_name[TALSH_TRACE_NUM_CATS]={"talsh","mem","instr","user"};
+static std::atomic<int> trace_on(0);                //tracing status (1:on, 0:off)
+static std::atomic<unsigned long long> trace_head(0); //total number of events recorded since the start
+static std::atomic<int> trace_num_threads(0);       //number of threads which have recorded events or have been named
+static std::atomic<int> trace_writers(0);           //number of recorders currently writing into the ring buffer
+static trace_event_t * trace_buf = NULL;            //ring buffer of trace events
+static size_t trace_capacity = 0;                   //capacity of the ring buffer (number of events)
+static char trace_thread_name[TALSH_TRACE_MAX_THREADS][TALSH_TRACE_NAME_LEN]; //thread names
+static thread_local int trace_thread = -1;          //internal thread id of the calling thread
+
+//LOCAL (PRIVATE) FUNCTION PROTOTYPES:
+static int trace_thread_id();
+static trace_event_t * trace_event_next();
+static void trace_event_done();
+static void trace_quiesce();
+static void trace_name_copy(char * dst, const char * src);
+static void trace_fprint_name(FILE * fp, const char * name);
+
+//FUNCTION DEFINITIONS:
+static int trace_thread_id()
+/** Returns the internal id of the calling thread (assigns a new one on the first call). **/
+{
+ if(trace_thread < 0){
+  trace_thread=trace_num_threads.fetch_add(1);
+  if(trace_thread < TALSH_TRACE_MAX_THREADS) trace_thread_name[trace_thread][0]='\0';
+ }
+ return trace_thread;
+}
+
+static trace_event_t * trace_event_next()
+/** Claims the next record in the ring buffer (NULL if tracing is off).
+    A claimed record must be released by trace_event_done() once written. **/
+{
+ if(trace_on.load(std::memory_order_relaxed) == 0) return NULL; //fast path
+ trace_writers.fetch_add(1); //announce the recorder before checking the status again (pairs with trace_quiesce)
+ if(trace_on.load() == 0){trace_writers.fetch_sub(1); return NULL;}
+ unsigned long long n = trace_head.fetch_add(1,std::memory_order_relaxed);
+ return &(trace_buf[n%trace_capacity]);
+}
+
+static void trace_event_done()
+/** Releases a record claimed by trace_event_next(). **/
+{
+ trace_writers.fetch_sub(1,std::memory_order_release);
+ return;
+}
+
+static void trace_quiesce()
+/** Waits until all in-flight recorders are done (tracing must already be off).
+    Recorders arriving later will see tracing off and will not touch the ring buffer. **/
+{
+ while(trace_writers.load() != 0) std::this_thread::yield();
+ return;
+}
+
+static void trace_name_copy(char * dst, const char * src)
+{
+ int i=0;
+ if(src != NULL){
+  while(i < TALSH_TRACE_NAME_LEN-1 && src[i] != '\0'){dst[i]=src[i]; ++i;}
+ }
+ dst[i]='\0';
+ return;
+}
+
+static void trace_fprint_name(FILE * fp, const char * name)
+/** Prints a name as a JSON string (without quotes). **/
+{
+ for(int i=0; i < TALSH_TRACE_NAME_LEN && name[i] != '\0'; ++i){
+  if(name[i] == '"' || name[i] == '\\' || name[i] < ' '){fputc('_',fp);}else{fputc(name[i],fp);}
+ }
+ return;
+}
+
+int talshTraceStart(size_t capacity)
+{
+ if(capacity == 0) return TALSH_INVALID_ARGS;
+ if(trace_on.load() != 0) return TALSH_ALREADY_INITIALIZED;
+ trace_quiesce(); //recorders claimed before the last stop may still be writing
+ if(trace_buf != NULL && trace_capacity != capacity){free(trace_buf); trace_buf=NULL; trace_capacity=0;}
+ if(trace_buf == NULL){
+  trace_buf=(trace_event_t*)malloc(capacity*sizeof(trace_event_t));
+  if(trace_buf == NULL) return TRY_LATER;
+  trace_capacity=capacity;
+ }
+ memset(trace_buf,0,trace_capacity*sizeof(trace_event_t)); //unwritten records have a null kind
+ trace_head.store(0);
+ trace_on.store(1);
+ return TALSH_SUCCESS;
+}
+
+int talshTraceStop()
+{
+ if(trace_on.exchange(0) == 0) return TALSH_NOT_INITIALIZED;
+ trace_quiesce(); //all claimed records are complete on return (safe to export)
+ return TALSH_SUCCESS;
+}
+
+int talshTraceClear()
+{
+ trace_on.store(0);
+ trace_quiesce(); //do not free the ring buffer under in-flight recorders
+ if(trace_buf != NULL){free(trace_buf); trace_buf=NULL;}
+ trace_capacity=0; trace_head.store(0);
+ return TALSH_SUCCESS;
+}
+
+int talshTraceIsOn()
+{
+ return trace_on.load(std::memory_order_relaxed);
+}
+
+size_t talshTraceCount()
+{
+ return (size_t)(trace_head.load());
+}
+
+void talshTraceThreadName(const char * name)
+{
+ int tid = trace_thread_id();
+ if(tid < TALSH_TRACE_MAX_THREADS) trace_name_copy(&(trace_thread_name[tid][0]),name);
+ return;
+}
+
+void talshTraceComplete(int category, const char * name, double time_begin, double time_end, long long arg)
+{
+ trace_event_t * ev = trace_event_next();
+ if(ev != NULL){
+  ev->time_begin=time_begin; ev->time_end=time_end; ev->value=0.0; ev->arg=arg;
+  ev->thread=trace_thread_id(); ev->kind=TRACE_EVENT_COMPLETE; ev->category=(char)category;
+  trace_name_copy(ev->name,name);
+  trace_event_done();
+ }
+ return;
+}
+
+void talshTraceAsync(int category, const char * name, long long id, double time_begin, double time_end)
+{
+ trace_event_t * ev = trace_event_next();
+ if(ev != NULL){
+  ev->time_begin=time_begin; ev->time_end=time_end; ev->value=0.0; ev->arg=id;
+  ev->thread=trace_thread_id(); ev->kind=TRACE_EVENT_ASYNC; ev->category=(char)category;
+  trace_name_copy(ev->name,name);
+  trace_event_done();
+ }
+ return;
+}
+
+void talshTraceCounter(int category, const char * name, double value)
+{
+ trace_event_t * ev = trace_event_next();
+ if(ev != NULL){
+  ev->time_begin=time_sys_sec(); ev->time_end=ev->time_begin; ev->value=value; ev->arg=0;
+  ev->thread=trace_thread_id(); ev->kind=TRACE_EVENT_COUNTER; ev->category=(char)category;
+  trace_name_copy(ev->name,name);
+  trace_event_done();
+ }
+ return;
+}
+
+int talshTraceExport(const char * file_name, int process_id)
+/** Exports the recorded events into a file in the Chrome trace JSON format.
+    Time stamps are converted to microseconds. **/
+{
+ int cat,nthr;
+ unsigned long long head,first,n;
+ const trace_event_t * ev;
+ const char * sep = ",\n";
+ FILE * fp;
+
+ if(file_name == NULL) return TALSH_INVALID_ARGS;
+ if(trace_buf == NULL) return TALSH_OBJECT_IS_EMPTY;
+ fp=fopen(file_name,"w"); if(fp == NULL) return TALSH_FAILURE;
+ head=trace_head.load(); first=0; if(head > trace_capacity) first=head-trace_capacity;
+ fprintf(fp,"{\"displayTimeUnit\":\"ms\",\"otherData\":{\"events_recorded\":%llu,\"events_lost\":%llu},\n",head,first);
+ fprintf(fp,"\"traceEvents\":[\n");
+ fprintf(fp,"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"Process %d\"}}",process_id,process_id);
+ nthr=trace_num_threads.load(); if(nthr > TALSH_TRACE_MAX_THREADS) nthr=TALSH_TRACE_MAX_THREADS;
+ for(int i=0; i < nthr; ++i){
+  if(trace_thread_name[i][0] != '\0'){
+   fprintf(fp,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"",process_id,i);
+   trace_fprint_name(fp,&(trace_thread_name[i][0])); fprintf(fp,"\"}}");
+  }
+ }
+ for(n=first; n < head; ++n){
+  ev=&(trace_buf[n%trace_capacity]);
+  cat=(int)(ev->category); if(cat < 0 || cat >= TALSH_TRACE_NUM_CATS) cat=TALSH_TRACE_CAT_USER;
+  switch(ev->kind){
+  case TRACE_EVENT_COMPLETE:
+   fprintf(fp,"%s{\"name\":\"",sep); trace_fprint_name(fp,ev->name);
+   fprintf(fp,"\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"arg\":%lld}}",
+           trace_cat_name[cat],ev->time_begin*1e6,(ev->time_end-ev->time_begin)*1e6,process_id,ev->thread,ev->arg);
+   break;
+  case TRACE_EVENT_ASYNC:
+   fprintf(fp,"%s{\"name\":\"",sep); trace_fprint_name(fp,ev->name);
+   fprintf(fp,"\",\"cat\":\"%s\",\"ph\":\"b\",\"id\":%lld,\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+           trace_cat_name[cat],ev->arg,ev->time_begin*1e6,process_id,ev->thread);
+   fprintf(fp,"%s{\"name\":\"",sep); trace_fprint_name(fp,ev->name);
+   fprintf(fp,"\",\"cat\":\"%s\",\"ph\":\"e\",\"id\":%lld,\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+           trace_cat_name[cat],ev->arg,ev->time_end*1e6,process_id,ev->thread);
+   break;
+  case TRACE_EVENT_COUNTER:
+   fprintf(fp,"%s{\"name\":\"",sep); trace_fprint_name(fp,ev->name);
+   fprintf(fp,"\",\"cat\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"value\":%.17g}}",
+           trace_cat_name[cat],ev->time_begin*1e6,process_id,ev->value);
+   break;
+  default: //record is being written concurrently (ignore)
+   break;
+  }
+ }
+ fprintf(fp,"\n]}\n");
+ if(fclose(fp) != 0) return TALSH_FAILURE;
+ return TALSH_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/** ExaTensor::TAL-SH: Low-overhead event tracer (ring buffer) with Chrome trace export.
+AUTHOR: Dmitry I. Lyakh (Liakh): quant4me@gmail.com
+REVISION: 2020/05/07
+
+Copyright (C) 2014-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+This file is part of ExaTensor.
+
+ExaTensor is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+ExaTensor is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with ExaTensor. If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------------------
+NOTES:
+ # Events are recorded into a fixed-size ring buffer of binary records:
+   Once the buffer is full, the oldest events are overwritten. Recording
+   an event is a few atomic operations plus a record copy, thus it can
+   be done from any thread without locking.
+ # Start, stop, and clear wait for the in-flight recorders to finish their
+   records before returning, thus the ring buffer is never reallocated or
+   freed under a recorder. These control functions themselves must not be
+   called concurrently with each other.
+ # All time stamps are in seconds as returned by time_sys_sec() (timer.h),
+   which is the same clock used for the TAVP instruction time stamps and
+   for the execution time of Host TAL-SH tasks.
+ # The recorded events are exported in the Chrome trace JSON format
+   (chrome://tracing, Perfetto UI), one file per process (MPI rank):
+   Complete events are shown per thread, asynchronous events (instruction
+   lifecycle stages) are shown per asynchronous id, counters as graphs.
+ # The export must not run concurrently with event recording: Stop tracing first.
+**/
+
+#ifndef TALSH_TRACE_H_
+#define TALSH_TRACE_H_
+
+#include <stddef.h>
+
+//Trace event categories:
+#define TALSH_TRACE_CAT_TALSH 0 //TAL-SH tensor operations
+#define TALSH_TRACE_CAT_MEM 1   //memory manager events
+#define TALSH_TRACE_CAT_INSTR 2 //TAVP tensor instruction lifecycle
+#define TALSH_TRACE_CAT_USER 3  //user-defined events
+#define TALSH_TRACE_NUM_CATS 4  //number of trace event categories
+
+#define TALSH_TRACE_NAME_LEN 32 //max event name length (including the terminating null): Longer names are truncated
+#define TALSH_TRACE_MAX_THREADS 256 //max number of distinct (named) threads in a trace
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+//Start tracing (allocates the ring buffer for <capacity> events, clears previously recorded events):
+ int talshTraceStart(size_t capacity);
+//Stop tracing (recorded events are kept until the next start or clear):
+ int talshTraceStop();
+//Release the ring buffer and all recorded events (stops tracing):
+ int talshTraceClear();
+//Check whether tracing is on (1) or off (0):
+ int talshTraceIsOn();
+//Get the number of recorded events (may exceed the ring buffer capacity, then the oldest events are lost):
+ size_t talshTraceCount();
+//Label the calling thread in the exported trace:
+ void talshTraceThreadName(const char * name);
+//Record a complete event [time_begin:time_end] on the calling thread:
+ void talshTraceComplete(int category, const char * name, double time_begin, double time_end, long long arg);
+//Record an asynchronous event [time_begin:time_end] associated with an asynchronous id (e.g., instruction id):
+ void talshTraceAsync(int category, const char * name, long long id, double time_begin, double time_end);
+//Record a counter value at the current time:
+ void talshTraceCounter(int category, const char * name, double value);
+//Export the recorded events into a file in the Chrome trace JSON format:
+ int talshTraceExport(const char * file_name, int process_id);
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TALSH_TRACE_H_
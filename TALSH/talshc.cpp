@@ -65,6 +65,7 @@ FOR DEVELOPER(s):
 #include "mem_manager.h"
 #include "talsh_complex.h"
 #include "talsh.h"
+#include "nvtx_profile.h"
 
 //PARAMETERS:
 static int VERBOSE=1;     //verbosity for errors
@@ -85,6 +86,8 @@ static int talsh_mic[MAX_MICS_PER_NODE]={DEV_OFF}; //current MIC status: {DEV_OF
 static int talsh_amd[MAX_AMDS_PER_NODE]={DEV_OFF}; //current AMD status: {DEV_OFF,DEV_ON,DEV_ON_BLAS}
 // Failure statistics:
 static unsigned long long int not_clean_count=0LL; //number of times a NOT_CLEAN status was returned (possible indication of a memory leak)
+// Host statistics:
+static talsh_stats_t host_stats; //Host (CP-TAL) run-time statistics (protected by <talsh_lock>)
 
 //INTERNAL TYPES:
 // Host task:
@@ -92,7 +95,25 @@ typedef struct{
  int task_error; //task error code (-1:empty or in progress; 0:success; >0:error code)
  int host_id;    //-1:uninitialized (empty task); 0:initialized (non-empty)
  unsigned int coherence; //coherence control value
+ double time_perm_in;    //time (sec) spent in input tensor permutations (-1.0: not available)
+ double time_mmul;       //time (sec) spent in matrix multiplication (-1.0: not available)
+ double time_perm_out;   //time (sec) spent in output tensor permutation (-1.0: not available)
 } host_task_t;
+// Host-only tensor operation (parameters of its CP-TAL kernel):
+#define HOST_TENS_OP_PRODUCT 1 //tensor product (Hadamard, Khatri-Rao, Kronecker)
+#define HOST_TENS_OP_TRACE 2   //tensor trace (partial or full)
+typedef struct{
+ int kind;                    //operation kind (HOST_TENS_OP_XXX)
+ const char * name;           //operation name (profiling and tracing)
+ int prof_color;              //profiling color
+ int num_args;                //number of tensor arguments (destination first)
+ int ptrn[MAX_TENSOR_RANK*2]; //digital index pattern
+ int conj_bits;               //argument complex conjugation bits
+ int accumulative;            //accumulate in VS overwrite destination tensor: [YEP|NOPE]
+ double scale_real;           //scaling value (real part)
+ double scale_imag;           //scaling value (imaginary part)
+ double flops;                //real Flop count (multiplied by 4 for complex data kinds)
+} host_tens_op_t;
 
 //PROTOTYPES OF IMPORTED FUNCTIONS:
 #ifdef __cplusplus
@@ -100,20 +121,29 @@ extern "C"{
 #endif
 // CP-TAL tensor operations:
 int cpu_tensor_block_init(void * dftr, double val_real, double val_imag, int arg_conj);
-int cpu_tensor_block_slice(void * lftr, void * dftr, const int * offsets, int accumulative);
-int cpu_tensor_block_insert(void * lftr, void * dftr, const int * offsets, int accumulative);
+int cpu_tensor_block_slice(void * lftr, void * dftr, const int * offsets, const int * dim_perm, int accumulative);
+int cpu_tensor_block_insert(void * lftr, void * dftr, const int * offsets, const int * dim_perm, int accumulative);
 int cpu_tensor_block_copy(const int * contr_ptrn, void * lftr, void * dftr, int arg_conj);
 int cpu_tensor_block_add(const int * contr_ptrn, void * lftr, void * dftr,
                          double scale_real, double scale_imag, int arg_conj);
 int cpu_tensor_block_contract(const int * contr_ptrn, void * lftr, void * rftr, void * dftr,
-                              double scale_real, double scale_imag, int arg_conj, int accumulative);
+                              double scale_real, double scale_imag, int arg_conj, int accumulative, double * phase_times,
+                              int math_mode);
+int cpu_tensor_block_product(const int * prod_ptrn, void * lftr, void * rftr, void * dftr,
+                             double scale_real, double scale_imag, int arg_conj, int accumulative);
+int cpu_tensor_block_trace(const int * trace_ptrn, void * lftr, void * dftr,
+                           double scale_real, double scale_imag, int arg_conj, int accumulative);
 int cpu_tensor_block_decompose_svd(const char absorb, void * dftr, void * lftr, void * rftr, void * sftr);
 // Contraction pattern conversion:
 int talsh_get_contr_ptrn_str2dig(const char * c_str, int * dig_ptrn,
                                  int * drank, int * lrank, int * rrank, int * conj_bits);
+int talsh_get_prod_ptrn_str2dig(const char * c_str, int * dig_ptrn,
+                                int * drank, int * lrank, int * rrank, int * conj_bits);
+int talsh_get_trace_ptrn_str2dig(const char * c_str, int * dig_ptrn, int * drank, int * lrank, int * conj_bits);
 // Fortran tensor block aliasing:
 int talsh_tensor_f_assoc(const talsh_tens_t * talsh_tens, int image_id, void ** tensF);
 int talsh_tensor_f_dissoc(void * tensF);
+int talsh_tensor_f_commit(void * tensF);
 int talsh_update_f_scalar(void * tensF, int data_kind, void * gmem_p);
 #ifdef __cplusplus
 }
@@ -159,6 +189,9 @@ static int talshTensorIsHealthy(const talsh_tens_t * talsh_tens);
 static int talshTaskConstruct(talsh_task_t * talsh_task, int dev_kind, int coh_ctrl, int data_kind = NO_TYPE);
 static int talshTaskSetArg(talsh_task_t * talsh_task, talsh_tens_t * talsh_tens_p, int image_id);
 static int talshTaskFinalize(talsh_task_t * talsh_task, int task_status);
+// Execute a Host-only tensor operation:
+static int talsh_host_tensor_op(const host_tens_op_t * op, talsh_tens_t * tens[], int dev_id, int dev_kind,
+                                int copy_ctrl, talsh_task_t * tsk, int blocking);
 #ifdef __cplusplus
 }
 #endif
@@ -181,6 +214,9 @@ static int host_task_clean(host_task_t * host_task)
  if(host_task == NULL) return TALSH_INVALID_ARGS;
  host_task->task_error=-1;
  host_task->host_id=-1;
+ host_task->time_perm_in=-1.0;
+ host_task->time_mmul=-1.0;
+ host_task->time_perm_out=-1.0;
  return TALSH_SUCCESS;
 }
 
@@ -249,6 +285,7 @@ static void host_task_print(const host_task_t * host_task)
   printf(" Host task status       : %d\n",host_task->task_error);
   printf(" Host task device id    : %d\n",host_task->host_id);
   printf(" Host task coherence_var: %u\n",host_task->coherence);
+  printf(" Host task phase times  : %f %f %f\n",host_task->time_perm_in,host_task->time_mmul,host_task->time_perm_out);
   printf("#END OF MESSAGE\n");
  }
  return;
@@ -609,7 +646,10 @@ int talshInit(size_t * host_buf_size,    //inout: Host Argument Buffer size in b
 #endif
  talsh_gpu_beg=gpu_beg; talsh_gpu_end=gpu_end;
  omp_init_nest_lock(&talsh_lock);
- talsh_on=1; talsh_begin_time=clock();
+ host_stats.tasks_submitted=0; host_stats.tasks_completed=0; host_stats.tasks_deferred=0; host_stats.tasks_failed=0;
+ host_stats.flops=0.0; host_stats.traffic_in=0.0; host_stats.traffic_out=0.0; host_stats.time_active=0.0;
+ host_stats.time_perm_in=0.0; host_stats.time_mmul=0.0; host_stats.time_perm_out=0.0;
+ talsh_on=1; talsh_begin_time=clock(); host_stats.time_start=talsh_begin_time;
 #pragma omp flush
  return TALSH_SUCCESS;
 }
@@ -629,6 +669,7 @@ int talshShutdown()
  for(i=0;i<MAX_MICS_PER_NODE;i++) talsh_mic[i]=DEV_OFF;
  for(i=0;i<MAX_AMDS_PER_NODE;i++) talsh_amd[i]=DEV_OFF;
  omp_destroy_nest_lock(&talsh_lock);
+ if(prof_get_backend() == PROF_BACKEND_TIMER) prof_report(); //print profiled regions (timer aggregator)
 #pragma omp flush
  if(errc) return TALSH_FAILURE;
  return TALSH_SUCCESS;
@@ -988,7 +1029,9 @@ double talshDeviceGetFlops(int dev_kind, int dev_id)
   total_flops+=talshDeviceGetFlops(DEV_AMD_GPU);
   break;
  case DEV_HOST:
-  total_flops=0.0;
+  omp_set_nest_lock(&talsh_lock);
+  total_flops=host_stats.flops;
+  omp_unset_nest_lock(&talsh_lock);
   break;
  case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
@@ -1054,7 +1097,21 @@ int talshStats(int dev_id,   //in: device id (either flat or kind specific devic
    }
    break;
   case DEV_HOST:
-   rc=TALSH_NOT_IMPLEMENTED; //`Implement
+   omp_set_nest_lock(&talsh_lock);
+   host_stats.time_active=((double)(clock()-host_stats.time_start))/CLOCKS_PER_SEC;
+   printf("\n#MSG(TAL-SH::CP-TAL): Statistics on Host:\n");
+   printf(" Number of tasks submitted: %llu\n",host_stats.tasks_submitted);
+   printf(" Number of tasks completed: %llu\n",host_stats.tasks_completed);
+   printf(" Number of tasks deferred : %llu\n",host_stats.tasks_deferred);
+   printf(" Number of tasks failed   : %llu\n",host_stats.tasks_failed);
+   printf(" Number of Flops processed: %G\n",host_stats.flops);
+   printf(" Time active (sec)        : %f\n",host_stats.time_active);
+   printf(" Time in permutations in  : %f\n",host_stats.time_perm_in);
+   printf(" Time in matrix multiply  : %f\n",host_stats.time_mmul);
+   printf(" Time in permutations out : %f\n",host_stats.time_perm_out);
+   printf("#END_MSG\n");
+   omp_unset_nest_lock(&talsh_lock);
+   rc=TALSH_SUCCESS;
    break;
   case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
@@ -1122,7 +1179,7 @@ int talshTensorIsEmpty(const talsh_tens_t * tens_block)
 }
 
 int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor block on entrance, constructed tensor block on exit
-                         int data_kind,                 //in: data kind: {R4,R8,C4,C8,NO_TYPE}
+                         int data_kind,                 //in: data kind: {R2,RB2,R4,R8,C4,C8,NO_TYPE}
                          int tens_rank,                 //in: tensor block rank (number of dimensions)
                          const int tens_dims[],         //in: tensor block dimension extents
                          int dev_id,                    //in: flat device ID on which the tensor block will reside
@@ -1142,6 +1199,8 @@ int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor bl
 {
  int i,j,dev_num,dev_kind,dksize,errc,already_allocated,use_hab;
  size_t tvol,tsize;
+ uint16_t hval;
+ uint16_t *hp;
  float fval;
  float *fp;
  double *dp;
@@ -1219,6 +1278,13 @@ int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor bl
       if(errc) errc=NOT_CLEAN; //initialization failed, tensor block value is undefined, but one may continue
      }else{
       switch(data_kind){
+       case R2:
+       case RB2:
+        if(data_kind == R2){hval = talshFloat16Set((float)init_val_real);}else{hval = talshBFloat16Set((float)init_val_real);}
+        hp = (uint16_t*)(tens_block->dev_rsc[0].gmem_p);
+#pragma omp parallel for shared(tvol,hp,hval) schedule(guided)
+        for(size_t l=0; l < tvol; l++) hp[l]=hval;
+        break;
        case R4:
         fval = (float)init_val_real;
         fp = (float*)(tens_block->dev_rsc[0].gmem_p);
@@ -1266,51 +1332,32 @@ int talshTensorConstruct_(talsh_tens_t * tens_block, int data_kind, int tens_ran
 }
 
 int talshTensorImportData(talsh_tens_t * tens_block, //inout: defined tensor block
-                          int data_kind,             //in: imported data kind: {R4,R8,C4,C8}
+                          int data_kind,             //in: imported data kind: {R2,RB2,R4,R8,C4,C8}
                           const void * ext_data)     //in: pointer to the imported external data
-/** Imports tensor body by copying data from <ext_data> into tensor body on Host. **/
+/** Imports tensor body by copying data from <ext_data> into tensor body on Host.
+    If the Host tensor body image is of a different data kind, the imported data
+    are converted into it (real kinds {R2,RB2,R4,R8} and complex kinds {C4,C8}). **/
 {
- int errc;
- size_t l,vol;
+ int i,n,errc;
+ int devs[TALSH_MAX_DEV_PRESENT],dtks[TALSH_MAX_DEV_PRESENT];
+ size_t vol;
  void * body_ptr;
 
 #pragma omp flush
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
  errc=TALSH_SUCCESS;
- if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(tens_block == NULL || ext_data == NULL) return TALSH_INVALID_ARGS;
  if(talshTensorIsEmpty(tens_block) == YEP) return TALSH_OBJECT_IS_EMPTY;
- errc=talshTensorGetBodyAccess(tens_block,&body_ptr,data_kind,0,DEV_HOST);
+ if(tens_valid_data_kind(data_kind) != YEP || data_kind == NO_TYPE) return TALSH_INVALID_ARGS;
+ errc=talshTensorPresence(tens_block,&n,devs,dtks,DEV_HOST);
+ if(errc != TALSH_SUCCESS) return errc;
+ if(n <= 0) return TALSH_NOT_FOUND;
+ i=0; while(i < n-1 && dtks[i] != data_kind) ++i; //prefer the Host image of the same data kind
+ errc=talshTensorGetBodyAccess(tens_block,&body_ptr,dtks[i],0,DEV_HOST);
  if(errc == TALSH_SUCCESS){
   vol=talshTensorVolume(tens_block);
   if(vol > 0){
-   float * dr4p = (float*)body_ptr;
-   const float * sr4p = (const float*)ext_data;
-   double * dr8p = (double*)body_ptr;
-   const double * sr8p = (const double*)ext_data;
-   talshComplex4 * dc4p = (talshComplex4*)body_ptr;
-   const talshComplex4 * sc4p = (const talshComplex4*)ext_data;
-   talshComplex8 * dc8p = (talshComplex8*)body_ptr;
-   const talshComplex8 * sc8p = (const talshComplex8*)ext_data;
-   switch(data_kind){
-    case R4:
-#pragma omp parallel for shared(vol,dr4p,sr4p) schedule(guided)
-     for(l=0;l<vol;++l) dr4p[l]=sr4p[l];
-     break;
-    case R8:
-#pragma omp parallel for shared(vol,dr8p,sr8p) schedule(guided)
-     for(l=0;l<vol;++l) dr8p[l]=sr8p[l];
-     break;
-    case C4:
-#pragma omp parallel for shared(vol,dc4p,sc4p) schedule(guided)
-     for(l=0;l<vol;++l) dc4p[l]=sc4p[l];
-     break;
-    case C8:
-#pragma omp parallel for shared(vol,dc8p,sc8p) schedule(guided)
-     for(l=0;l<vol;++l) dc8p[l]=sc8p[l];
-     break;
-    default:
-     errc=TALSH_INVALID_ARGS;
-   }
+   errc=talsh_data_convert(dtks[i],body_ptr,data_kind,ext_data,vol);
   }else{
    errc=TALSH_FAILURE;
   }
@@ -1629,6 +1676,8 @@ int talshTensorGetScalar(talsh_tens_t * tens_block, double * scalar_real, double
    errc=talshTensorGetBodyAccess(tens_block,&body_p,dtk[j],0,DEV_HOST);
    if(errc == TALSH_SUCCESS){
     switch(dtk[j]){
+     case R2: *scalar_real = (double)talshFloat16Get(*((talshFloat16*)body_p)); *scalar_imag = 0.0; break;
+     case RB2: *scalar_real = (double)talshBFloat16Get(*((talshBFloat16*)body_p)); *scalar_imag = 0.0; break;
      case R4: *scalar_real = (double)(*((float*)body_p)); *scalar_imag = 0.0; break;
      case R8: *scalar_real = *((double*)body_p); *scalar_imag = 0.0; break;
      case C4: cx4 = *((talshComplex4*)body_p); *scalar_real = (double)talshComplex4Real(cx4); *scalar_imag = (double)talshComplex4Imag(cx4); break;
@@ -1717,6 +1766,8 @@ void talshTensorPrintBody(const talsh_tens_t * tens_block, double thresh)
  const void * body_p;
  size_t l,vol;
  talsh_tens_shape_t tshape;
+ const uint16_t * bph;
+ float fval;
  const float * bpr4;
  const double * bpr8;
  const talshComplex4 * bpc4;
@@ -1738,6 +1789,17 @@ void talshTensorPrintBody(const talsh_tens_t * tens_block, double thresh)
       nd=(unsigned int)(tshape.num_dim);
       tdims=(unsigned int *)(tshape.dims);
       switch(dtks[0]){
+       case R2:
+       case RB2:
+        bph=(const uint16_t *)body_p;
+        for(l=0;l<vol;++l){
+         if(dtks[0] == R2){fval=talshFloat16Get(bph[l]);}else{fval=talshBFloat16Get(bph[l]);}
+         if((double)(ABS(fval)) >= thresh){
+          printf("\n%E",fval);
+          if(nd > 0){tens_elem_mlndx_f(l,nd,tdims,mlndx); for(i=0;i<nd;++i) printf(" %u",mlndx[i]);}
+         }
+        }
+        break;
        case R4:
         bpr4=(const float *)body_p;
         if(nd > 0){
@@ -2447,6 +2509,7 @@ int talshTaskTime(talsh_task_t * talsh_task, double * total, double * comput, do
 {
  int sts,errc;
  float tot_tm,in_tm,out_tm,comp_tm,mmul_tm;
+ host_task_t *host_task_p;
 #ifndef NO_GPU
  cudaTask_t *cuda_task_p;
 #endif
@@ -2463,6 +2526,11 @@ int talshTaskTime(talsh_task_t * talsh_task, double * total, double * comput, do
   case DEV_HOST:
    tot_tm=(float)(talsh_task->exec_time); in_tm=-1.0f; out_tm=-1.0f; comp_tm=-1.0f; mmul_tm=-1.0f;
    if(tot_tm < 0.0f) errc=TALSH_FAILURE;
+   host_task_p=(host_task_t*)(talsh_task->task_p);
+   if(host_task_p->time_mmul >= 0.0){ //phase timings are only available for CP-TAL tensor contractions
+    in_tm=(float)(host_task_p->time_perm_in); mmul_tm=(float)(host_task_p->time_mmul);
+    out_tm=(float)(host_task_p->time_perm_out); comp_tm=in_tm+mmul_tm+out_tm;
+   }
    break;
   case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
@@ -3033,7 +3101,7 @@ double talshTensorOpGetFlopCount(const talsh_tens_op_t * tens_op)
 
  double flops = 0.0;
  if(tens_op != NULL){
-  if(tens_op->data_kind == R4 || tens_op->data_kind == R8){
+  if(tens_op->data_kind == R2 || tens_op->data_kind == RB2 || tens_op->data_kind == R4 || tens_op->data_kind == R8){
    fma = 2.0;
   }else if(tens_op->data_kind == C4 || tens_op->data_kind == C8){
    fma = 8.0;
@@ -3510,7 +3578,7 @@ int talshTensorInit(talsh_tens_t * dtens,
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr;
- clock_t ctm;
+ double ttm;
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr;
@@ -3609,13 +3677,17 @@ int talshTensorInit(talsh_tens_t * dtens,
    //Mark soure images unavailable:
    dtens->avail[0] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
+   ttm=time_sys_sec();
+   prof_push("talshTensorInit",0);
    errc=cpu_tensor_block_init(dftr,val_real,val_imag,0); //blocking call (`no conjugation bits)
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-ttm; //wall clock time (same clock as the trace time stamps)
+   if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorInit",ttm,ttm+tsk->exec_time,(long long)talshTensorVolume(dtens));
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
    //Host task finalization and coherence control:
@@ -3724,15 +3796,17 @@ int talshTensorSlice(talsh_tens_t * dtens, //inout: destination tensor block (te
                      int dev_kind,
                      int copy_ctrl,
                      int accumulative,
-                     talsh_task_t * talsh_task)
+                     talsh_task_t * talsh_task,
+                     const int * permutation)
 /** Tensor slicing dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc;
+ int i,j,n,devid,dvk,dvn,dimg,limg,dcp,lcp,errc,trivial;
+ int prm[MAX_TENSOR_RANK];
  unsigned int coh_ctrl,coh,cohd,cohl;
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr,*lftr;
- clock_t ctm;
+ double ttm;
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr,*lctr;
@@ -3757,10 +3831,26 @@ int talshTensorSlice(talsh_tens_t * dtens, //inout: destination tensor block (te
  if(talshTensorIsHealthy(dtens) != YEP || talshTensorIsHealthy(ltens) != YEP){
   tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
  }
+ //Get the index permutation (dimension i of <ltens> is dimension prm[i] of <dtens>):
+ trivial=YEP; errc=0; n=talshTensorRank(ltens);
+ for(i=0;i<n;++i){
+  if(permutation != NULL){prm[i]=permutation[i];}else{prm[i]=i+1;}
+  if(prm[i] < 1 || prm[i] > n){errc=1; break;}
+  for(j=0;j<i;++j){if(prm[j] == prm[i]) break;}
+  if(j < i){errc=1; break;} //repeated dimension
+  if(prm[i] != i+1) trivial=NOPE;
+ }
+ if(errc){ //<permutation> is not a permutation of 1..rank
+  tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
  //Determine the execution device (devid:[dvk,dvn]):
  if(dev_kind == DEV_DEFAULT){ //device kind is not specified explicitly
   if(dev_id == DEV_DEFAULT){ //neither specific device nor device kind are specified: Find one
-   devid=talsh_find_optimal_device(dtens,ltens);
+   if(trivial == YEP){
+    devid=talsh_find_optimal_device(dtens,ltens);
+   }else{
+    devid=talshFlatDevId(DEV_HOST,0); //permuted slicing/insertion is only implemented on Host
+   }
    if(devid < 0 || devid >= DEV_MAX){
     tsk->task_error=104; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
    }
@@ -3853,13 +3943,17 @@ int talshTensorSlice(talsh_tens_t * dtens, //inout: destination tensor block (te
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_slice(lftr,dftr,offsets,accumulative); //blocking call
+   ttm=time_sys_sec();
+   prof_push("talshTensorSlice",1);
+   errc=cpu_tensor_block_slice(lftr,dftr,offsets,prm,accumulative); //blocking call
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-ttm; //wall clock time (same clock as the trace time stamps)
+   if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorSlice",ttm,ttm+tsk->exec_time,(long long)talshTensorVolume(dtens));
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
@@ -3893,6 +3987,10 @@ int talshTensorSlice(talsh_tens_t * dtens, //inout: destination tensor block (te
    break;
   case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
+   if(trivial != YEP){ //permuted slicing/insertion is not implemented on GPU
+    tsk->task_error=130; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
+    return TALSH_NOT_IMPLEMENTED;
+   }
    //Associate TAL-SH tensor images with <tensBlck_t> objects:
    errc=talsh_tensor_c_assoc(dtens,dimg,&dctr);
    if(errc || dctr == NULL){
@@ -3973,9 +4071,10 @@ int talshTensorSlice(talsh_tens_t * dtens, //inout: destination tensor block (te
 }
 
 int talshTensorSlice_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * offsets,
-                      int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task) //Fortran wrapper
+                      int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task,
+                      const int * permutation) //Fortran wrapper
 {
- return talshTensorSlice(dtens,ltens,offsets,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+ return talshTensorSlice(dtens,ltens,offsets,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task,permutation);
 }
 
 int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
@@ -3985,15 +4084,17 @@ int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
                       int dev_kind,
                       int copy_ctrl,
                       int accumulative,
-                      talsh_task_t * talsh_task)
+                      talsh_task_t * talsh_task,
+                      const int * permutation)
 /** Tensor insertion dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc;
+ int i,j,n,devid,dvk,dvn,dimg,limg,dcp,lcp,errc,trivial;
+ int prm[MAX_TENSOR_RANK];
  unsigned int coh_ctrl,coh,cohd,cohl;
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr,*lftr;
- clock_t ctm;
+ double ttm;
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr,*lctr;
@@ -4018,10 +4119,26 @@ int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
  if(talshTensorIsHealthy(dtens) != YEP || talshTensorIsHealthy(ltens) != YEP){
   tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
  }
+ //Get the index permutation (dimension i of <ltens> is dimension prm[i] of <dtens>):
+ trivial=YEP; errc=0; n=talshTensorRank(ltens);
+ for(i=0;i<n;++i){
+  if(permutation != NULL){prm[i]=permutation[i];}else{prm[i]=i+1;}
+  if(prm[i] < 1 || prm[i] > n){errc=1; break;}
+  for(j=0;j<i;++j){if(prm[j] == prm[i]) break;}
+  if(j < i){errc=1; break;} //repeated dimension
+  if(prm[i] != i+1) trivial=NOPE;
+ }
+ if(errc){ //<permutation> is not a permutation of 1..rank
+  tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
  //Determine the execution device (devid:[dvk,dvn]):
  if(dev_kind == DEV_DEFAULT){ //device kind is not specified explicitly
   if(dev_id == DEV_DEFAULT){ //neither specific device nor device kind are specified: Find one
-   devid=talsh_find_optimal_device(dtens,ltens);
+   if(trivial == YEP){
+    devid=talsh_find_optimal_device(dtens,ltens);
+   }else{
+    devid=talshFlatDevId(DEV_HOST,0); //permuted slicing/insertion is only implemented on Host
+   }
    if(devid < 0 || devid >= DEV_MAX){
     tsk->task_error=104; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
    }
@@ -4114,13 +4231,17 @@ int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_insert(lftr,dftr,offsets,accumulative); //blocking call
+   ttm=time_sys_sec();
+   prof_push("talshTensorInsert",1);
+   errc=cpu_tensor_block_insert(lftr,dftr,offsets,prm,accumulative); //blocking call
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-ttm; //wall clock time (same clock as the trace time stamps)
+   if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorInsert",ttm,ttm+tsk->exec_time,(long long)talshTensorVolume(dtens));
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
@@ -4154,6 +4275,10 @@ int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
    break;
   case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
+   if(trivial != YEP){ //permuted slicing/insertion is not implemented on GPU
+    tsk->task_error=130; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
+    return TALSH_NOT_IMPLEMENTED;
+   }
    //Associate TAL-SH tensor images with <tensBlck_t> objects:
    errc=talsh_tensor_c_assoc(dtens,dimg,&dctr);
    if(errc || dctr == NULL){
@@ -4234,9 +4359,10 @@ int talshTensorInsert(talsh_tens_t * dtens, //inout: destination tensor block
 }
 
 int talshTensorInsert_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * offsets,
-                       int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task) //Fortran wrapper
+                       int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task,
+                       const int * permutation) //Fortran wrapper
 {
- return talshTensorInsert(dtens,ltens,offsets,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+ return talshTensorInsert(dtens,ltens,offsets,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task,permutation);
 }
 
 int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
@@ -4254,7 +4380,7 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr,*lftr;
- clock_t ctm;
+ double ttm;
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr,*lctr;
@@ -4379,13 +4505,17 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
+   ttm=time_sys_sec();
+   prof_push("talshTensorCopy",2);
    errc=cpu_tensor_block_copy(contr_ptrn,lftr,dftr,conj_bits); //blocking call
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-ttm; //wall clock time (same clock as the trace time stamps)
+   if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorCopy",ttm,ttm+tsk->exec_time,(long long)talshTensorVolume(dtens));
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
@@ -4521,8 +4651,7 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr,*lftr;
- clock_t ctm;
- double tms;
+ double tms,ttm;
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr,*lctr;
@@ -4654,13 +4783,17 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
+   ttm=time_sys_sec();
+   prof_push("talshTensorAdd",2);
    errc=cpu_tensor_block_add(contr_ptrn,lftr,dftr,scale_real,scale_imag,conj_bits); //blocking call
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-ttm; //wall clock time (same clock as the trace time stamps)
+   if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorAdd",ttm,ttm+tsk->exec_time,(long long)talshTensorVolume(dtens));
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
@@ -4792,7 +4925,8 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
                         int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
                         int copy_ctrl,             //in: copy control (COPY_XXX), defaults to COPY_MTT
                         int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
-                        talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
+                        talsh_task_t * talsh_task, //inout: TAL-SH task (must be clean on entrance)
+                        int math_mode)             //in: Host arithmetic mode for R8/C8 data (CONTR_MATH_XXX)
 /** Tensor contraction dispatcher **/
 {
  int j,devid,dvk,dvn,dimg,limg,rimg,dcp,lcp,rcp,errc;
@@ -4801,8 +4935,7 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
  talsh_task_t * tsk;
  host_task_t * host_task;
  void *dftr,*lftr,*rftr;
- clock_t ctm;
- double tms;
+ double tms,htms,hflops,phase_times[3];
 #ifndef NO_GPU
  cudaTask_t * cuda_task;
  tensBlck_t *dctr,*lctr,*rctr;
@@ -4827,7 +4960,7 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
  }
  coh_ctrl=copy_ctrl;
  //Check function arguments:
- if(dtens == NULL || ltens == NULL || rtens == NULL){
+ if(dtens == NULL || ltens == NULL || rtens == NULL || math_mode < CONTR_MATH_DEFAULT || math_mode > CONTR_MATH_COMPENSATED){
   tsk->task_error=100; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
  }
  if(talshTensorIsEmpty(dtens) != NOPE || talshTensorIsEmpty(ltens) != NOPE || talshTensorIsEmpty(rtens) != NOPE){
@@ -4956,13 +5089,41 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    if(cohr == COPY_D || (cohr == COPY_M && rtens->dev_rsc[rimg].dev_id != devid)) rtens->avail[rimg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_contract(contr_ptrn,lftr,rftr,dftr,scale_real,scale_imag,conj_bits,accumulative); //blocking call
+   omp_set_nest_lock(&talsh_lock); host_stats.tasks_submitted++; omp_unset_nest_lock(&talsh_lock);
+   htms=time_sys_sec(); //wall clock time (same clock as the trace time stamps)
+   prof_push("talshTensorContract",3);
+   errc=cpu_tensor_block_contract(contr_ptrn,lftr,rftr,dftr,scale_real,scale_imag,conj_bits,accumulative,phase_times,
+                                  math_mode); //blocking call
+   prof_pop();
    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //explicit update is needed for scalar destinations
     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
     if(j) errc=TALSH_FAILURE;
    }
-   tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
+   if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(dftr); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+   tsk->exec_time=time_sys_sec()-htms;
+   hflops=2.0*sqrt(((double)talshTensorVolume(dtens))*((double)talshTensorVolume(ltens))*((double)talshTensorVolume(rtens)));
+   if(dtens->data_kind[dimg] == C4 || dtens->data_kind[dimg] == C8) hflops*=4.0; //4 mul, 4 add
+   if(talshTraceIsOn()){
+    talshTraceComplete(TALSH_TRACE_CAT_TALSH,"talshTensorContract",htms,htms+tsk->exec_time,(long long)hflops);
+    if(errc == TALSH_SUCCESS){ //phases are nested inside the contraction event
+     talshTraceComplete(TALSH_TRACE_CAT_TALSH,"Permute In",htms,htms+phase_times[0],0);
+     talshTraceComplete(TALSH_TRACE_CAT_TALSH,"GEMM",htms+phase_times[0],htms+phase_times[0]+phase_times[1],(long long)hflops);
+     talshTraceComplete(TALSH_TRACE_CAT_TALSH,"Permute Out",htms+phase_times[0]+phase_times[1],
+                        htms+phase_times[0]+phase_times[1]+phase_times[2],0);
+    }
+   }
+   omp_set_nest_lock(&talsh_lock);
+   if(errc == TALSH_SUCCESS){
+    host_task->time_perm_in=phase_times[0]; host_task->time_mmul=phase_times[1]; host_task->time_perm_out=phase_times[2];
+    host_stats.tasks_completed++;
+    host_stats.flops+=hflops;
+    host_stats.time_perm_in+=phase_times[0]; host_stats.time_mmul+=phase_times[1]; host_stats.time_perm_out+=phase_times[2];
+   }else if(errc == TRY_LATER || errc == DEVICE_UNABLE){
+    host_stats.tasks_deferred++;
+   }else{
+    host_stats.tasks_failed++;
+   }
+   omp_unset_nest_lock(&talsh_lock);
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
@@ -5098,9 +5259,306 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
 
 int talshTensorContract_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
                          double scale_real, double scale_imag, int dev_id, int dev_kind,
-                         int copy_ctrl, int accumulative, talsh_task_t * talsh_task) //Fortran wrapper
+                         int copy_ctrl, int accumulative, talsh_task_t * talsh_task, int math_mode) //Fortran wrapper
+{
+ return talshTensorContract(cptrn,dtens,ltens,rtens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task,
+                            math_mode);
+}
+
+static int talsh_host_tensor_op(const host_tens_op_t * op, //in: Host-only tensor operation (kernel and its parameters)
+                                talsh_tens_t * tens[],     //inout: tensor arguments (destination first)
+                                int dev_id,                //in: device id (flat or kind-specific)
+                                int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
+                                int copy_ctrl,             //in: copy control (COPY_XXX)
+                                talsh_task_t * tsk,        //inout: TAL-SH task (must be clean on entrance)
+                                int blocking)              //in: YEP: blocking call (<tsk> is destroyed here), NOPE: user task
+/** Executes a Host-only tensor operation with validated arguments: Chooses the tensor body images, applies
+    the coherence control, executes the operation kernel on Host, and updates the Host statistics. **/
+{
+ int i,j,devid,dvk,dvn,nargs,errc,img[MAX_TENSOR_OPERANDS],cpd[MAX_TENSOR_OPERANDS];
+ unsigned int coh_ctrl,coh[MAX_TENSOR_OPERANDS];
+ host_task_t * host_task;
+ void * ftr[MAX_TENSOR_OPERANDS];
+ double htms,hflops;
+
+ nargs=op->num_args; coh_ctrl=copy_ctrl;
+ //Determine the execution device (devid:[dvk,dvn]):
+ if(dev_kind == DEV_DEFAULT){ //device kind is not specified explicitly
+  if(dev_id == DEV_DEFAULT){ //neither specific device nor device kind are specified: Host (no accelerator kernels yet)
+   devid=talshFlatDevId(DEV_HOST,0);
+  }else{ //<dev_id> is a flat device id
+   devid=dev_id;
+  }
+  dvn=talshKindDevId(devid,&dvk);
+  if(dvn < 0){tsk->task_error=105; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;}
+ }else{ //device kind is specified explicitly
+  if(valid_device_kind(dev_kind) != YEP){
+   tsk->task_error=106; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+  }
+  dvk=dev_kind;
+  if(dev_id == DEV_DEFAULT){ //kind-specific device id is not specified: Implicit
+   dvn=-1; //kind-specific device id will be chosen by the corresponding runtime
+  }else{ //kind-specific device id is specified
+   dvn=dev_id;
+   if(talshFlatDevId(dvk,dvn) >= DEV_MAX){
+    tsk->task_error=107; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+   }
+  }
+ }
+ if(dvk != DEV_HOST){ //only implemented on Host
+  tsk->task_error=104; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_NOT_IMPLEMENTED;
+ }
+ //Choose the tensor body image for each tensor argument and adjust the coherence control:
+ for(i=0;i<nargs;++i){
+  coh[i]=argument_coherence_get_value(coh_ctrl,nargs,i);
+  img[i]=talsh_choose_image_for_device(tens[i],coh[i],&(cpd[i]),dvk,dvn);
+  if(i > 0 && cpd[i] != 0){ //an intermediate copy was introduced on Host (source arguments)
+   if(coh[i] == COPY_K){ //adjust coherence control
+    coh[i]=COPY_M; j=argument_coherence_set_value(&coh_ctrl,nargs,i,coh[i]);
+   }else if(coh[i] == COPY_T){
+    coh[i]=COPY_D; j=argument_coherence_set_value(&coh_ctrl,nargs,i,coh[i]);
+   }
+  }
+ }
+ for(i=0;i<nargs;++i){
+  if(img[i] < 0){tsk->task_error=108; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_FAILURE;}
+ }
+ //Check data kind of each image (must match):
+ for(i=1;i<nargs;++i){
+  if(tens[i]->data_kind[img[i]] != tens[0]->data_kind[img[0]]){
+   tsk->task_error=109; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+  }
+ }
+ //Construct the TAL-SH task:
+ if(talshTaskStatus(tsk) == TALSH_TASK_EMPTY){
+  errc=talshTaskConstruct(tsk,dvk,coh_ctrl,tens[0]->data_kind[img[0]]);
+  if(errc){tsk->task_error=110; if(blocking == YEP) j=talshTaskDestroy(tsk); return errc;}
+  for(i=0;i<nargs;++i){
+   errc=talshTaskSetArg(tsk,tens[i],img[i]);
+   if(errc){tsk->task_error=111+i; if(blocking == YEP) j=talshTaskDestroy(tsk); return errc;}
+  }
+ }else{
+  tsk->task_error=114; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_OBJECT_NOT_EMPTY;
+ }
+ //Associate TAL-SH tensor images with <tensor_block_t> objects:
+ for(i=0;i<nargs;++i){
+  errc=talsh_tensor_f_assoc(tens[i],img[i],&(ftr[i]));
+  if(errc || ftr[i] == NULL){
+   for(j=i-1;j>=0;--j) errc=talsh_tensor_f_dissoc(ftr[j]);
+   tsk->task_error=115+i; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+  }
+ }
+ //Get the Host task:
+ host_task=(host_task_t*)(tsk->task_p);
+ devid=talshFlatDevId(DEV_HOST,0); //execution device
+ //Discard all output images except the source one:
+ errc=talsh_tensor_image_discard_other(tens[0],img[0]); //the only remaining image 0 is the source image
+ if(errc != TALSH_SUCCESS){
+  for(i=nargs-1;i>=0;--i){j=talsh_tensor_f_dissoc(ftr[i]); if(j) errc=TALSH_FAILURE;}
+  j=host_task_record(host_task,coh_ctrl,13);
+  j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
+  tsk->task_error=118; if(blocking == YEP) j=talshTaskDestroy(tsk);
+  return errc;
+ }
+ //Mark source images unavailable:
+ tens[0]->avail[0] = NOPE;
+ for(i=1;i<nargs;++i){
+  if(coh[i] == COPY_D || (coh[i] == COPY_M && tens[i]->dev_rsc[img[i]].dev_id != devid)) tens[i]->avail[img[i]] = NOPE;
+ }
+ //Execute the tensor operation:
+ omp_set_nest_lock(&talsh_lock); host_stats.tasks_submitted++; omp_unset_nest_lock(&talsh_lock);
+ htms=time_sys_sec(); //wall clock time (same clock as the trace time stamps)
+ prof_push(op->name,op->prof_color);
+ switch(op->kind){
+  case HOST_TENS_OP_PRODUCT:
+   errc=cpu_tensor_block_product(op->ptrn,ftr[1],ftr[2],ftr[0],op->scale_real,op->scale_imag,op->conj_bits,op->accumulative);
+   break;
+  case HOST_TENS_OP_TRACE:
+   errc=cpu_tensor_block_trace(op->ptrn,ftr[1],ftr[0],op->scale_real,op->scale_imag,op->conj_bits,op->accumulative);
+   break;
+  default:
+   errc=TALSH_NOT_IMPLEMENTED;
+ }
+ prof_pop();
+ if(errc == TALSH_SUCCESS && talshTensorRank(tens[0]) == 0){ //explicit update is needed for scalar destinations
+  j=talsh_update_f_scalar(ftr[0],tens[0]->data_kind[0],tens[0]->dev_rsc[0].gmem_p);
+  if(j) errc=TALSH_FAILURE;
+ }
+ if(errc == TALSH_SUCCESS){j=talsh_tensor_f_commit(ftr[0]); if(j) errc=TALSH_FAILURE;} //reduced-precision destinations
+ tsk->exec_time=time_sys_sec()-htms;
+ hflops=op->flops; if(tens[0]->data_kind[0] == C4 || tens[0]->data_kind[0] == C8) hflops*=4.0;
+ if(talshTraceIsOn()) talshTraceComplete(TALSH_TRACE_CAT_TALSH,op->name,htms,htms+tsk->exec_time,(long long)hflops);
+ omp_set_nest_lock(&talsh_lock);
+ if(errc == TALSH_SUCCESS){
+  host_stats.tasks_completed++; host_stats.flops+=hflops;
+ }else if(errc == TRY_LATER || errc == DEVICE_UNABLE){
+  host_stats.tasks_deferred++;
+ }else{
+  host_stats.tasks_failed++;
+ }
+ omp_unset_nest_lock(&talsh_lock);
+ //Dissociate <tensor_block_t> objects:
+ for(i=nargs-1;i>=0;--i){j=talsh_tensor_f_dissoc(ftr[i]); if(j) errc=TALSH_FAILURE;}
+ //Host task finalization and coherence control:
+ if(errc){ //task error
+  if(errc == TRY_LATER || errc == DEVICE_UNABLE){
+   tens[0]->avail[0] = YEP; for(i=1;i<nargs;++i) tens[i]->avail[img[i]] = YEP;
+  }else{
+   errc=TALSH_FAILURE;
+  }
+  j=host_task_record(host_task,coh_ctrl,13);
+  j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
+  tsk->task_error=119; if(blocking == YEP) j=talshTaskDestroy(tsk);
+  return errc;
+ }else{ //task success (host tasks perform finalization here)
+  errc=host_task_record(host_task,coh_ctrl,0); //record task success (finalized, no deferred coherence control on Host)
+  if(errc){tsk->task_error=120; if(blocking == YEP) j=talshTaskDestroy(tsk); return TALSH_FAILURE;}
+  tens[0]->avail[0] = YEP;
+ }
+ //If blocking call, complete it here:
+ if(errc == TALSH_SUCCESS && blocking == YEP){
+  errc=talshTaskWait(tsk,&j); if(errc == TALSH_SUCCESS && j != TALSH_TASK_COMPLETED) errc=TALSH_TASK_ERROR;
+  j=talshTaskDestroy(tsk); if(j != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc=j;
+ }
+ return errc;
+}
+
+int talshTensorProduct(const char * cptrn,        //in: C-string: symbolic tensor product pattern, e.g. "D(a,b,c)+=L(a,b)*R(a,c)"
+                       talsh_tens_t * dtens,      //inout: destination tensor block
+                       talsh_tens_t * ltens,      //inout: left source tensor block
+                       talsh_tens_t * rtens,      //inout: right source tensor block
+                       double scale_real,         //in: scaling value (real part), defaults to 1
+                       double scale_imag,         //in: scaling value (imaginary part), defaults to 0
+                       int dev_id,                //in: device id (flat or kind-specific)
+                       int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
+                       int copy_ctrl,             //in: copy control (COPY_XXX), defaults to COPY_MTT
+                       int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                       talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
+/** Tensor product (Hadamard, Khatri-Rao, Kronecker) dispatcher **/
+{
+ int j,drnk,lrnk,rrnk,conj_bits,errc;
+ talsh_task_t * tsk;
+ talsh_tens_t * tens[3];
+ host_tens_op_t op;
+ double tms;
+
+#pragma omp flush
+ if(LOGGING_OPS > 0){
+  printf("%s",cptrn); printf(" ");
+  talshTensorPrint(dtens); printf(" ");
+  talshTensorPrint(ltens); printf(" ");
+  talshTensorPrint(rtens); printf(" ");
+  printf(": Flop volume = %llu: Time (s) = ",talshTensorVolume(dtens));
+  tms=time_high_sec();
+ }
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ //Create a TAL-SH task:
+ if(talsh_task == NULL){
+  errc=talshTaskCreate(&tsk); if(errc) return errc; if(tsk == NULL) return TALSH_FAILURE;
+ }else{
+  tsk=talsh_task;
+ }
+ //Check function arguments:
+ if(dtens == NULL || ltens == NULL || rtens == NULL){
+  tsk->task_error=100; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
+ if(talshTensorIsEmpty(dtens) != NOPE || talshTensorIsEmpty(ltens) != NOPE || talshTensorIsEmpty(rtens) != NOPE){
+  tsk->task_error=101; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_OBJECT_IS_EMPTY;
+ }
+ if(talshTensorIsHealthy(dtens) != YEP || talshTensorIsHealthy(ltens) != YEP || talshTensorIsHealthy(rtens) != YEP){
+  tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+ }
+ //Check and parse the index correspondence pattern:
+ errc=talsh_get_prod_ptrn_str2dig(cptrn,op.ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
+ if(errc || drnk != talshTensorRank(dtens) || lrnk != talshTensorRank(ltens) || rrnk != talshTensorRank(rtens)){
+  tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
+ //Execute the tensor product on Host:
+ op.kind=HOST_TENS_OP_PRODUCT; op.name="talshTensorProduct"; op.prof_color=3; op.num_args=3;
+ op.conj_bits=conj_bits; op.accumulative=accumulative; op.scale_real=scale_real; op.scale_imag=scale_imag;
+ op.flops=2.0*((double)talshTensorVolume(dtens)); //1 mul, 1 add per destination element
+ tens[0]=dtens; tens[1]=ltens; tens[2]=rtens;
+ errc=talsh_host_tensor_op(&op,tens,dev_id,dev_kind,copy_ctrl,tsk,(talsh_task == NULL ? YEP : NOPE));
+#pragma omp flush
+ if(LOGGING_OPS > 0){
+  printf("%f\n",time_high_sec()-tms);
+ }
+ return errc;
+}
+
+int talshTensorProduct_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
+                        double scale_real, double scale_imag, int dev_id, int dev_kind,
+                        int copy_ctrl, int accumulative, talsh_task_t * talsh_task) //Fortran wrapper
+{
+ return talshTensorProduct(cptrn,dtens,ltens,rtens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+}
+
+int talshTensorTrace(const char * cptrn,        //in: C-string: symbolic tensor trace pattern, e.g. "D(a,b)+=L(a,i,b,i)"
+                     talsh_tens_t * dtens,      //inout: destination tensor block
+                     talsh_tens_t * ltens,      //inout: source tensor block
+                     double scale_real,         //in: scaling value (real part), defaults to 1
+                     double scale_imag,         //in: scaling value (imaginary part), defaults to 0
+                     int dev_id,                //in: device id (flat or kind-specific)
+                     int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
+                     int copy_ctrl,             //in: copy control (COPY_XX), defaults to COPY_MT
+                     int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                     talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
+/** Tensor trace (partial or full) dispatcher **/
+{
+ int j,drnk,lrnk,conj_bits,errc;
+ talsh_task_t * tsk;
+ talsh_tens_t * tens[2];
+ host_tens_op_t op;
+ double tms;
+
+#pragma omp flush
+ if(LOGGING_OPS > 0){
+  printf("%s",cptrn); printf(" ");
+  talshTensorPrint(dtens); printf(" ");
+  talshTensorPrint(ltens); printf(" ");
+  printf(": Flop volume = %llu: Time (s) = ",talshTensorVolume(ltens));
+  tms=time_high_sec();
+ }
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ //Create a TAL-SH task:
+ if(talsh_task == NULL){
+  errc=talshTaskCreate(&tsk); if(errc) return errc; if(tsk == NULL) return TALSH_FAILURE;
+ }else{
+  tsk=talsh_task;
+ }
+ //Check function arguments:
+ if(dtens == NULL || ltens == NULL){
+  tsk->task_error=100; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
+ if(talshTensorIsEmpty(dtens) != NOPE || talshTensorIsEmpty(ltens) != NOPE){
+  tsk->task_error=101; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_OBJECT_IS_EMPTY;
+ }
+ if(talshTensorIsHealthy(dtens) != YEP || talshTensorIsHealthy(ltens) != YEP){
+  tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+ }
+ //Check and parse the index correspondence pattern:
+ errc=talsh_get_trace_ptrn_str2dig(cptrn,op.ptrn,&drnk,&lrnk,&conj_bits);
+ if(errc || drnk != talshTensorRank(dtens) || lrnk != talshTensorRank(ltens)){
+  tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;
+ }
+ //Execute the tensor trace on Host:
+ op.kind=HOST_TENS_OP_TRACE; op.name="talshTensorTrace"; op.prof_color=3; op.num_args=2;
+ op.conj_bits=conj_bits; op.accumulative=accumulative; op.scale_real=scale_real; op.scale_imag=scale_imag;
+ op.flops=1.0; for(j=0;j<lrnk;++j){if(op.ptrn[j] > 0) op.flops*=(double)(ltens->shape_p->dims[j]);} //retained range
+ for(j=0;j<lrnk;++j){if(op.ptrn[j] < 0 && -op.ptrn[j]-1 > j) op.flops*=(double)(ltens->shape_p->dims[j]);} //traced range
+ tens[0]=dtens; tens[1]=ltens;
+ errc=talsh_host_tensor_op(&op,tens,dev_id,dev_kind,copy_ctrl,tsk,(talsh_task == NULL ? YEP : NOPE));
+#pragma omp flush
+ if(LOGGING_OPS > 0){
+  printf("%f\n",time_high_sec()-tms);
+ }
+ return errc;
+}
+
+int talshTensorTrace_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, double scale_real, double scale_imag,
+                      int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task) //Fortran wrapper
 {
- return talshTensorContract(cptrn,dtens,ltens,rtens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+ return talshTensorTrace(cptrn,dtens,ltens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
 }
 
 int talshTensorContractXL(const char * cptrn,   //in: C-string: symbolic contraction pattern, e.g. "D(a,b,c,d)+=L(c,i,j,a)*R(b,j,d,i)"
@@ -5577,6 +6035,11 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
    stens->avail[0] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
    errc=cpu_tensor_block_decompose_svd(absorb,dftr,lftr,rftr,sftr); //blocking call
+   if(errc == TALSH_SUCCESS){ //reduced-precision destinations
+    j=talsh_tensor_f_commit(lftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_commit(rftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_commit(sftr); if(j) errc=TALSH_FAILURE;
+   }
    //printf("#DEBUG(talshTensorDecomposeSVD): Executed SVD on CPU with status %d\n",errc);
    //Dissociate <tensor_block_t> objects:
    j=talsh_tensor_f_dissoc(sftr); if(j) errc=TALSH_FAILURE;
@@ -5870,6 +6333,8 @@ double talshTensorImageNorm1_cpu(const talsh_tens_t * talsh_tens)
  size_t j,n;
  int dtk[TALSH_MAX_DEV_PRESENT];
  double norm1;
+ talshFloat16 *h2p;
+ talshBFloat16 *b2p;
  float *r4p;
  double *r8p;
  talshComplex4 *c4p;
@@ -5894,6 +6359,16 @@ double talshTensorImageNorm1_cpu(const talsh_tens_t * talsh_tens)
 #pragma omp parallel for shared(r8p,n) reduction(+:norm1) schedule(guided)
        for(j=0;j<n;++j){norm1+=ABS(r8p[j]);}
        break;
+      case R2:
+       h2p=(talshFloat16*)(talsh_tens->dev_rsc[i].gmem_p);
+#pragma omp parallel for shared(h2p,n) reduction(+:norm1) schedule(guided)
+       for(j=0;j<n;++j){norm1+=(double)(ABS(talshFloat16Get(h2p[j])));}
+       break;
+      case RB2:
+       b2p=(talshBFloat16*)(talsh_tens->dev_rsc[i].gmem_p);
+#pragma omp parallel for shared(b2p,n) reduction(+:norm1) schedule(guided)
+       for(j=0;j<n;++j){norm1+=(double)(ABS(talshBFloat16Get(b2p[j])));}
+       break;
       case C4:
        c4p=(talshComplex4*)(talsh_tens->dev_rsc[i].gmem_p);
 #pragma omp parallel for shared(c4p,n) reduction(+:norm1) schedule(guided)
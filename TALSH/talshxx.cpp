@@ -27,6 +27,10 @@ namespace talsh{
 
 //Static constant storage:
 
+constexpr Float16 TensorData<Float16>::unity;
+constexpr Float16 TensorData<Float16>::zero;
+constexpr BFloat16 TensorData<BFloat16>::unity;
+constexpr BFloat16 TensorData<BFloat16>::zero;
 constexpr float TensorData<float>::unity;
 constexpr float TensorData<float>::zero;
 constexpr double TensorData<double>::unity;
@@ -39,10 +43,14 @@ constexpr std::complex<double> TensorData<std::complex<double>>::zero;
 
 //Helper functions:
 // Generic real/imaginary part extraction:
+double realPart(Float16 number){return static_cast<double>(talshFloat16Get(number.bits));}
+double realPart(BFloat16 number){return static_cast<double>(talshBFloat16Get(number.bits));}
 double realPart(float number){return static_cast<double>(number);}
 double realPart(double number){return number;}
 double realPart(std::complex<float> number){return static_cast<double>(number.real());}
 double realPart(std::complex<double> number){return number.real();}
+double imagPart(Float16 number){return 0.0;}
+double imagPart(BFloat16 number){return 0.0;}
 double imagPart(float number){return 0.0f;}
 double imagPart(double number){return 0.0;}
 double imagPart(std::complex<float> number){return static_cast<double>(number.imag());}
@@ -46,6 +46,8 @@ static const std::size_t DEFAULT_HOST_BUFFER_SIZE = TALSH_NO_HOST_BUFFER; //smal
 
 //Tensor data kind (static type VS numeric data kind constant conversions):
 
+const int REAL16 = R2;     //storage only (computed in REAL32)
+const int BFLOAT16 = RB2; //storage only (computed in REAL32)
 const int REAL32 = R4;
 const int REAL64 = R8;
 const int COMPLEX32 = C4;
@@ -57,6 +59,22 @@ struct TensorData{
  static constexpr bool supported = false;
 };
 
+template <>
+struct TensorData<Float16>{
+ static constexpr int kind = R2;
+ static constexpr bool supported = true;
+ static constexpr Float16 unity = {0x3C00};
+ static constexpr Float16 zero = {0x0000};
+};
+
+template <>
+struct TensorData<BFloat16>{
+ static constexpr int kind = RB2;
+ static constexpr bool supported = true;
+ static constexpr BFloat16 unity = {0x3F80};
+ static constexpr BFloat16 zero = {0x0000};
+};
+
 template <>
 struct TensorData<float>{
  static constexpr int kind = R4;
@@ -90,6 +108,8 @@ struct TensorData<std::complex<double>>{
 };
 
 template <int talsh_data_kind> struct TensorDataType{using value = void;};
+template <> struct TensorDataType<R2>{using value = Float16;};
+template <> struct TensorDataType<RB2>{using value = BFloat16;};
 template <> struct TensorDataType<R4>{using value = float;};
 template <> struct TensorDataType<R8>{using value = double;};
 template <> struct TensorDataType<C4>{using value = std::complex<float>;};
@@ -99,10 +119,14 @@ template <> struct TensorDataType<C8>{using value = std::complex<double>;};
 //Helper functions:
 
 // Generic real/imaginary part extraction:
+double realPart(Float16 number);
+double realPart(BFloat16 number);
 double realPart(float number);
 double realPart(double number);
 double realPart(std::complex<float> number);
 double realPart(std::complex<double> number);
+double imagPart(Float16 number);
+double imagPart(BFloat16 number);
 double imagPart(float number);
 double imagPart(double number);
 double imagPart(std::complex<float> number);
@@ -301,7 +325,8 @@ public:
                         const int device_kind = DEV_HOST,       //in: execution device kind
                         const int device_id = 0,                //in: execution device id
                         const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
-                        bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
+                        bool accumulative = true,               //in: accumulate versus overwrite the destination tensor
+                        int math_mode = CONTR_MATH_DEFAULT);    //in: Host arithmetic mode for R8/C8 data (CONTR_MATH_XXX)
 
  /** Performs an extra large tensor contraction of two tensors and accumulates the result into the current tensor:
      this += left * right * scalar_factor
@@ -318,6 +343,33 @@ public:
                           const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
                           bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
 
+ /** Performs an element-wise (Hadamard, Khatri-Rao, Kronecker) product of two tensors and accumulates
+     the result into the current tensor: this += left * right * scalar_factor, where each index of the
+     left and right tensors appears in the current tensor (no contracted indices), e.g. "D(a,b,c)+=L(a,b)*R(a,c)".
+     Returns an error code (0:success). **/
+ template <typename T = double>
+ int productAccumulate(TensorTask * task_handle,               //out: task handle associated with this operation or nullptr (synchronous)
+                       const std::string & pattern,            //in: tensor product pattern string
+                       Tensor & left,                          //in: left tensor
+                       Tensor & right,                         //in: right tensor
+                       const int device_kind = DEV_HOST,       //in: execution device kind (Host only for now)
+                       const int device_id = 0,                //in: execution device id
+                       const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
+                       bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
+
+ /** Takes a partial or full trace of a tensor and accumulates the result into the current tensor:
+     this += TRACE(left) * scalar_factor, where each index of the current tensor appears in the left tensor once
+     and each remaining index of the left tensor appears in it twice, e.g. "D(a,b)+=L(a,i,b,i)".
+     Returns an error code (0:success). **/
+ template <typename T = double>
+ int traceAccumulate(TensorTask * task_handle,               //out: task handle associated with this operation or nullptr (synchronous)
+                     const std::string & pattern,            //in: tensor trace pattern string
+                     Tensor & left,                          //in: left tensor
+                     const int device_kind = DEV_HOST,       //in: execution device kind (Host only for now)
+                     const int device_id = 0,                //in: execution device id
+                     const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
+                     bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
+
  /** Performs a matrix multiplication on two tensors and accumulates the result into the current tensor.
      Returns an error code (0:success). **/
  template <typename T = double>
@@ -829,7 +881,8 @@ int Tensor::contractAccumulate(TensorTask * task_handle,    //out: task handle a
                                const int device_kind,       //in: execution device kind
                                const int device_id,         //in: execution device id
                                const T factor,              //in: scalar factor (alpha)
-                               bool accumulative)           //in: accumulate in (default) VS overwrite destination tensor
+                               bool accumulative,           //in: accumulate in (default) VS overwrite destination tensor
+                               int math_mode)               //in: Host arithmetic mode for R8/C8 data (CONTR_MATH_XXX)
 {
  int errc = TALSH_SUCCESS;
  this->completeWriteTask();
@@ -845,7 +898,7 @@ int Tensor::contractAccumulate(TensorTask * task_handle,    //out: task handle a
   talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
   //++left; ++right; ++(*this);
   errc = talshTensorContract(contr_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
-                             COPY_MTT,accum,task_hl);
+                             COPY_MTT,accum,task_hl,math_mode);
   if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
    std::cout << "#ERROR(talsh::Tensor::contractAccumulate): talshTensorContract error " << errc << std::endl; //debug
   assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
@@ -860,7 +913,7 @@ int Tensor::contractAccumulate(TensorTask * task_handle,    //out: task handle a
   }
  }else{ //synchronous
   errc = talshTensorContract(contr_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
-                             COPY_MTT,accum);
+                             COPY_MTT,accum,NULL,math_mode);
   if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
    std::cout << "#ERROR(talsh::Tensor::contractAccumulate): talshTensorContract error " << errc << std::endl; //debug
   assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
@@ -907,6 +960,100 @@ int Tensor::contractAccumulateXL(TensorTask * task_handle,    //out: task handle
 }
 
 
+/** Performs an element-wise (Hadamard, Khatri-Rao, Kronecker) product of two tensors and accumulates
+    the result into the current tensor: this += left * right * scalar_factor **/
+template <typename T>
+int Tensor::productAccumulate(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                              const std::string & pattern, //in: tensor product pattern string
+                              Tensor & left,               //in: left tensor
+                              Tensor & right,              //in: right tensor
+                              const int device_kind,       //in: execution device kind
+                              const int device_id,         //in: execution device id
+                              const T factor,              //in: scalar factor (alpha)
+                              bool accumulative)           //in: accumulate in (default) VS overwrite destination tensor
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ int accum = YEP; if(!accumulative) accum = NOPE;
+ const char * prod_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr){ //asynchronous
+  bool task_empty = task_handle->isEmpty(); assert(task_empty);
+  talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
+  errc = talshTensorProduct(prod_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
+                            COPY_MTT,accum,task_hl);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::productAccumulate): talshTensorProduct error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+  if(errc == TALSH_SUCCESS){
+   task_handle->used_tensors_[0] = this;
+   task_handle->used_tensors_[1] = &left;
+   task_handle->used_tensors_[2] = &right;
+   task_handle->num_tensors_ = 3;
+   this->resetWriteTask(task_handle);
+  }else{
+   task_handle->clean();
+  }
+ }else{ //synchronous
+  errc = talshTensorProduct(prod_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
+                            COPY_MTT,accum,NULL);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::productAccumulate): talshTensorProduct error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+ }
+ return errc;
+}
+
+
+/** Takes a partial or full trace of a tensor and accumulates the result into the current tensor:
+    this += TRACE(left) * scalar_factor **/
+template <typename T>
+int Tensor::traceAccumulate(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                            const std::string & pattern, //in: tensor trace pattern string
+                            Tensor & left,               //in: left tensor
+                            const int device_kind,       //in: execution device kind
+                            const int device_id,         //in: execution device id
+                            const T factor,              //in: scalar factor (alpha)
+                            bool accumulative)           //in: accumulate in (default) VS overwrite destination tensor
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ int accum = YEP; if(!accumulative) accum = NOPE;
+ const char * trace_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ if(task_handle != nullptr){ //asynchronous
+  bool task_empty = task_handle->isEmpty(); assert(task_empty);
+  talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
+  errc = talshTensorTrace(trace_ptrn,dtens,ltens,realPart(factor),imagPart(factor),device_id,device_kind,
+                          COPY_MT,accum,task_hl);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::traceAccumulate): talshTensorTrace error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+  if(errc == TALSH_SUCCESS){
+   task_handle->used_tensors_[0] = this;
+   task_handle->used_tensors_[1] = &left;
+   task_handle->num_tensors_ = 2;
+   this->resetWriteTask(task_handle);
+  }else{
+   task_handle->clean();
+  }
+ }else{ //synchronous
+  errc = talshTensorTrace(trace_ptrn,dtens,ltens,realPart(factor),imagPart(factor),device_id,device_kind,
+                          COPY_MT,accum,NULL);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::traceAccumulate): talshTensorTrace error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+ }
+ return errc;
+}
+
+
 /** Performs a matrix multiplication on two tensors and accumulates the result into the current tensor. **/
 template <typename T>
 int Tensor::multiplyAccumulate(TensorTask * task_handle, //out: task handle associated with this operation or nullptr (synchronous)
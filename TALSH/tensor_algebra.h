@@ -75,7 +75,8 @@ FOR DEVELOPERS ONLY:
 
 //DATA KINDS (keep consistent with tensor_algebra.F90):
 #define NO_TYPE 0 //null type
-//#define R2 2    //half-precision float data kind
+#define R2 2      //half-precision float data kind (IEEE 754 binary16, storage only: computed in R4)
+#define RB2 3     //bfloat16 float data kind (storage only: computed in R4)
 #define R4 4      //single-precision float data kind
 #define R8 8      //double-precision float data kind
 //#define R16 10  //quadruple-precision float data kind
@@ -101,6 +102,11 @@ FOR DEVELOPERS ONLY:
 #define MEM_ALLOC_TMP_BUF 1
 #define MEM_ALLOC_ALL_BUF 2
 
+//HOST TENSOR CONTRACTION ARITHMETIC MODES FOR R8/C8 DATA (keep consistent with tensor_algebra.F90):
+#define CONTR_MATH_DEFAULT 0     //native precision (BLAS if available)
+#define CONTR_MATH_MIXED 1       //operands are multiplied in R4/C4, accumulation is done in R8/C8 (faster, less accurate)
+#define CONTR_MATH_COMPENSATED 2 //compensated (Kahan) accumulation over the contracted dimension (slower, more accurate)
+
 //ALIASES (keep consistent with tensor_algebra.F90):
 #define NOPE 0
 #define YEP 1
@@ -276,6 +282,9 @@ typedef struct{
  double traffic_in;                      //total number of bytes transferred in
  double traffic_out;                     //total number of bytes transferred out
  double time_active;                     //time in seconds device is active
+ double time_perm_in;                    //time in seconds spent in input tensor permutations (Host only)
+ double time_mmul;                       //time in seconds spent in matrix multiplication (Host only)
+ double time_perm_out;                   //time in seconds spent in output tensor permutation (Host only)
  clock_t time_start;                     //time when the library was initialized (internal use only)
 } talsh_stats_t;
 
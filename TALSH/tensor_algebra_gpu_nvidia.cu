@@ -2333,6 +2333,8 @@ int tens_valid_data_kind(int datk, int * datk_size)
  int datk_sz=-1;
  int ans=NOPE;
  switch(datk){
+  case R2: ans=YEP; datk_sz=sizeof(uint16_t); break; //real half (storage only)
+  case RB2: ans=YEP; datk_sz=sizeof(uint16_t); break; //real bfloat16 (storage only)
   case R4: ans=YEP; datk_sz=sizeof(float); break;    //real float
   case R8: ans=YEP; datk_sz=sizeof(double); break;   //real double
   case C4: ans=YEP; datk_sz=sizeof(float)*2; break;  //complex float
@@ -3121,6 +3123,9 @@ no GPU will be initialized. **/
     gpu_stats[i].traffic_in=0.0;
     gpu_stats[i].traffic_out=0.0;
     gpu_stats[i].time_active=0.0;
+    gpu_stats[i].time_perm_in=0.0;
+    gpu_stats[i].time_mmul=0.0;
+    gpu_stats[i].time_perm_out=0.0;
     gpu_stats[i].time_start=clock();
 //Accept GPU as ready (active):
     if(gpu_up[i] > GPU_OFF) n++;
@@ -49,6 +49,7 @@ void test_talsh_svd(int * ierr);
 void test_talsh_qc_xl(int * ierr);
 void test_talsh_qc(int * ierr);
 void test_nwchem_c(int * ierr);
+void test_talsh_half(int * ierr);
 #ifndef NO_GPU
 void test_nvtal_c(int * ierr);
 #endif
@@ -975,6 +976,114 @@ void test_nwchem_c(int * ierr)
 }
 
 
+//Exports the Host body of a tensor of data kind <data_kind> into an R4 array (with conversion):
+static int half_test_export(talsh_tens_t * tens, int data_kind, float * vals)
+{
+ void * body_p;
+ int errc=talshTensorGetBodyAccess(tens,&body_p,data_kind,0,DEV_HOST);
+ if(errc == TALSH_SUCCESS) errc=talsh_data_convert(R4,(void*)vals,data_kind,body_p,talshTensorVolume(tens));
+ return errc;
+}
+
+//Returns the max element-wise deviation |vals-refs| in units of (eps*|refs| + tiny), that is, <= 1 means agreement:
+static double half_test_deviation(const float * vals, const float * refs, size_t vol, double eps)
+{
+ const double tiny = 1e-6; //absolute slack for results in the subnormal range
+ double dev=0.0;
+ for(size_t l=0; l<vol; ++l){
+  double d=fabs((double)(vals[l])-(double)(refs[l]))/(eps*fabs((double)(refs[l]))+tiny);
+  if(d > dev) dev=d;
+ }
+ return dev;
+}
+
+void test_talsh_half(int * ierr)
+/** Tests the reduced-precision storage data kinds R2 (FP16) and RB2 (BF16) on Host: construction,
+    import/export with conversion, permuted addition and contraction. The reduced-precision results are
+    compared element-wise against the same operations in R4 executed on the same (rounded) input values:
+    Each element must agree within the rounding error of the storage data kind, eps*|R4 value| + 1e-6,
+    where eps = 2^-11 for R2 and 2^-8 for RB2 (unit roundoff of round-to-nearest-even). **/
+{
+ const int NA=12, NB=10, NC=14, ND=16; //dimension extents
+ const int half_kinds[] = {R2,RB2};
+ const double half_eps[] = {1.0/2048.0,1.0/256.0};
+ const int dims_l[] = {NA,NB,NC}, dims_r[] = {NC,ND}, dims_a[] = {NB,NA,NC}, dims_c[] = {NA,ND,NB};
+ const int dev = talshFlatDevId(DEV_HOST,0);
+ size_t host_buffer_size = 64*1024*1024; //bytes
+ int host_arg_max,errc;
+
+ *ierr=0;
+ errc=talshInit(&host_buffer_size,&host_arg_max,0,NULL,0,NULL,0,NULL);
+ printf(" TAL-SH has been initialized: Status %d: Host buffer size = %lu \n",errc,host_buffer_size); if(errc){*ierr=1; return;};
+ const size_t vol_l=NA*NB*NC, vol_r=NC*ND, vol_a=NB*NA*NC, vol_c=NA*ND*NB;
+ double * orig_l = (double*)malloc(vol_l*sizeof(double));
+ double * orig_r = (double*)malloc(vol_r*sizeof(double));
+ float * vals_l = (float*)malloc(vol_l*sizeof(float));
+ float * vals_r = (float*)malloc(vol_r*sizeof(float));
+ float * vals = (float*)malloc((vol_a > vol_c ? vol_a : vol_c)*sizeof(float));
+ float * refs = (float*)malloc((vol_a > vol_c ? vol_a : vol_c)*sizeof(float));
+ if(orig_l == NULL || orig_r == NULL || vals_l == NULL || vals_r == NULL || vals == NULL || refs == NULL){*ierr=2; return;}
+ srand(17);
+ for(size_t l=0; l<vol_l; ++l) orig_l[l]=((double)rand())/((double)RAND_MAX)-0.5;
+ for(size_t l=0; l<vol_r; ++l) orig_r[l]=((double)rand())/((double)RAND_MAX)-0.5;
+ for(int k=0; k<2; ++k){
+  const int dtk=half_kinds[k];
+  const double eps=half_eps[k];
+  double dev_io,dev_add,dev_ctr;
+  talsh_tens_t ltens,rtens,atens,ctens,ltens4,rtens4,atens4,ctens4;
+  printf(" Data kind %d (eps = %.3e):\n",dtk,eps);
+  //Construct tensors (the destinations are initialized to an exactly representable value):
+  errc=talshTensorClean(&ltens); errc+=talshTensorClean(&rtens); errc+=talshTensorClean(&atens); errc+=talshTensorClean(&ctens);
+  errc+=talshTensorClean(&ltens4); errc+=talshTensorClean(&rtens4); errc+=talshTensorClean(&atens4); errc+=talshTensorClean(&ctens4);
+  if(errc){*ierr=3; return;}
+  errc=talshTensorConstruct(&ltens,dtk,3,dims_l,dev); if(errc){*ierr=4; return;}
+  errc=talshTensorConstruct(&rtens,dtk,2,dims_r,dev); if(errc){*ierr=5; return;}
+  errc=talshTensorConstruct(&atens,dtk,3,dims_a,dev,NULL,-1,NULL,0.25); if(errc){*ierr=6; return;}
+  errc=talshTensorConstruct(&ctens,dtk,3,dims_c,dev,NULL,-1,NULL,-0.5); if(errc){*ierr=7; return;}
+  errc=talshTensorConstruct(&ltens4,R4,3,dims_l,dev); if(errc){*ierr=8; return;}
+  errc=talshTensorConstruct(&rtens4,R4,2,dims_r,dev); if(errc){*ierr=9; return;}
+  errc=talshTensorConstruct(&atens4,R4,3,dims_a,dev,NULL,-1,NULL,0.25); if(errc){*ierr=10; return;}
+  errc=talshTensorConstruct(&ctens4,R4,3,dims_c,dev,NULL,-1,NULL,-0.5); if(errc){*ierr=11; return;}
+  //Import R8 data with conversion and export it back into R4:
+  errc=talshTensorImportData(&ltens,R8,(const void*)orig_l); if(errc){*ierr=12; return;}
+  errc=talshTensorImportData(&rtens,R8,(const void*)orig_r); if(errc){*ierr=13; return;}
+  errc=half_test_export(&ltens,dtk,vals_l); if(errc){*ierr=14; return;}
+  errc=half_test_export(&rtens,dtk,vals_r); if(errc){*ierr=15; return;}
+  dev_io=0.0;
+  for(size_t l=0; l<vol_l; ++l){refs[0]=(float)orig_l[l]; double d=half_test_deviation(&vals_l[l],refs,1,eps); if(d > dev_io) dev_io=d;}
+  for(size_t l=0; l<vol_r; ++l){refs[0]=(float)orig_r[l]; double d=half_test_deviation(&vals_r[l],refs,1,eps); if(d > dev_io) dev_io=d;}
+  printf("  Import/export: Deviation = %.3f\n",dev_io); if(dev_io > 1.0){*ierr=16; return;}
+  //R4 tensors get exactly the same (rounded) input values:
+  errc=talshTensorImportData(&ltens4,R4,(const void*)vals_l); if(errc){*ierr=17; return;}
+  errc=talshTensorImportData(&rtens4,R4,(const void*)vals_r); if(errc){*ierr=18; return;}
+  //Permuted addition:
+  errc=talshTensorAdd("D(b,a,c)+=L(a,b,c)",&atens,&ltens,0.75,0.0,dev); if(errc){*ierr=19; return;}
+  errc=talshTensorAdd("D(b,a,c)+=L(a,b,c)",&atens4,&ltens4,0.75,0.0,dev); if(errc){*ierr=20; return;}
+  errc=half_test_export(&atens,dtk,vals); if(errc){*ierr=21; return;}
+  errc=half_test_export(&atens4,R4,refs); if(errc){*ierr=22; return;}
+  dev_add=half_test_deviation(vals,refs,vol_a,eps);
+  printf("  D(b,a,c)+=L(a,b,c)*0.75: Deviation = %.3f\n",dev_add); if(dev_add > 1.0){*ierr=23; return;}
+  //Contraction:
+  errc=talshTensorContract("D(a,d,b)+=L(a,b,c)*R(c,d)",&ctens,&ltens,&rtens,1.0,0.0,dev); if(errc){*ierr=24; return;}
+  errc=talshTensorContract("D(a,d,b)+=L(a,b,c)*R(c,d)",&ctens4,&ltens4,&rtens4,1.0,0.0,dev); if(errc){*ierr=25; return;}
+  errc=half_test_export(&ctens,dtk,vals); if(errc){*ierr=26; return;}
+  errc=half_test_export(&ctens4,R4,refs); if(errc){*ierr=27; return;}
+  dev_ctr=half_test_deviation(vals,refs,vol_c,eps);
+  printf("  D(a,d,b)+=L(a,b,c)*R(c,d): Deviation = %.3f\n",dev_ctr); if(dev_ctr > 1.0){*ierr=28; return;}
+  //Destruct tensors:
+  errc=talshTensorDestruct(&ctens4); errc+=talshTensorDestruct(&atens4);
+  errc+=talshTensorDestruct(&rtens4); errc+=talshTensorDestruct(&ltens4);
+  errc+=talshTensorDestruct(&ctens); errc+=talshTensorDestruct(&atens);
+  errc+=talshTensorDestruct(&rtens); errc+=talshTensorDestruct(&ltens);
+  if(errc){*ierr=29; return;}
+ }
+ free(refs); free(vals); free(vals_r); free(vals_l); free(orig_r); free(orig_l);
+ errc=talshShutdown();
+ printf(" TAL-SH has been shut down: Status %d\n",errc); if(errc){*ierr=30; return;};
+ return;
+}
+
+
 #ifndef NO_GPU
 void test_nvtal_c(int * ierr)
 {
@@ -60,6 +60,16 @@ struct TensorDataKind{
  static const int Type = 0;
 };
 
+template <>
+struct TensorDataKind<talsh::Float16>{
+ static const int Type = R2;
+};
+
+template <>
+struct TensorDataKind<talsh::BFloat16>{
+ static const int Type = RB2;
+};
+
 template <>
 struct TensorDataKind<float>{
  static const int Type = R4;
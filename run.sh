@@ -17,6 +17,18 @@ export QF_GPUS_PER_PROCESS=0      #number of discrete NVIDIA GPU's per MPI proce
 export QF_MICS_PER_PROCESS=0      #number of discrete Intel Xeon Phi's per MPI process (optional)
 export QF_AMDS_PER_PROCESS=0      #number of discrete AMD GPU's per MPI process (optional)
 export QF_NUM_THREADS=8           #initial number of CPU threads per MPI process (irrelevant, keep it 8)
+#export QF_COMM_REGULARIZER=16    #max number of in-flight tensor instructions per tensor block in TAVP-MNG dispatch (optional, activates locality-ordered dispatch, 0 is off)
+#export QF_COMM_RANK_FETCHES=8    #max number of outstanding one-sided fetches per remote MPI rank in TAVP-WRK (optional, 0 is unlimited)
+#export QF_COMM_AGGREGATE=1       #coalesces prefetches targeting the same remote MPI rank in TAVP-WRK into back-to-back batches (optional, 0 is off)
+#export QF_COMM_PIPELINED=1       #fetches remote tensors larger than the DDSS chunk size in TAVP-WRK as multiple outstanding chunks (optional, 0 is off)
+#export QF_REPLICA_CACHE=12       #read-only replicas of remote tensors in TAVP-WRK: percent of host RAM (optional, 0 is off)
+#export QF_TMP_RECYCLE=1         #recycles Host buffers of released temporary tensors in TAVP-WRK (optional, 0 is off)
+#export QF_DEP_DEPTH=1           #max number of deferred accesses per tensor dependency chain in TAVP-WRK (optional, 0 is unlimited, 1 is the former two-level pipeline)
+#export QF_SHM_ARENA=256          #node-local shared-memory arena backing persistent tensors in TAVP-WRK: MB per MPI process (optional, 0 is off)
+#export QF_LOAD_AWARE_DISPATCH=16 #load-aware dispatch: max number of pending tensor instructions of an idle TAVP-WRK (optional, negative is off)
+#export QF_TOPOLOGY_MAP=hosts.map #topology map: lines "<rank> <node>" or hostfile "<node> slots=<N>" (optional, defaults to MPI shared-memory domains)
+#export QF_BLOCK_PROFILE=block.prof #device performance profile: activates the adaptive tensor decomposition (optional, measured at startup if the file does not exist)
+#export QF_TRACE_EVENTS=1000000  #event tracer: ring buffer capacity in events, exports exatns_trace.<rank>.json in Chrome trace format (optional, 0 is off)
 
 #OpenMP generic:
 export OMP_NUM_THREADS=$QF_NUM_THREADS #initial number of OpenMP threads per MPI process